@@ -0,0 +1,40 @@
+/**
+ * @file CounterRandom.hpp
+ *
+ * @copyright Copyright (c) 2024 Emergency-Optimizers
+ */
+
+#pragma once
+
+/* external libraries */
+#include <cstdint>
+#include <limits>
+/* internal libraries */
+#include "Utils.hpp"
+
+// counter based random number generator, reseeding only resets a key and a counter so it is cheap to do per event
+class CounterRandom {
+ private:
+    uint64_t key = 0;
+    uint64_t counter = 0;
+
+ public:
+    using result_type = uint64_t;
+
+    CounterRandom() = default;
+    explicit CounterRandom(const uint64_t key) : key(key) { }
+    static constexpr result_type min() {
+        return std::numeric_limits<result_type>::min();
+    }
+    static constexpr result_type max() {
+        return std::numeric_limits<result_type>::max();
+    }
+    void seed(const uint64_t newKey) {
+        key = newKey;
+        counter = 0;
+    }
+    result_type operator()() {
+        // the n-th draw of a SplitMix64 sequence starting at key
+        return splitMix64(key + counter++ * 0x9E3779B97F4A7C15ULL);
+    }
+};
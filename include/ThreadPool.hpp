@@ -0,0 +1,38 @@
+/**
+ * @file ThreadPool.hpp
+ *
+ * @copyright Copyright (c) 2024 Emergency-Optimizers
+ */
+
+#pragma once
+
+/* external libraries */
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// fixed set of worker threads started once and reused for every batch of tasks
+class ThreadPool {
+ private:
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable tasksAvailable;
+    std::condition_variable tasksFinished;
+    // current batch, tasks are handed out by index until all are taken
+    const std::function<void(const size_t)>* task = nullptr;
+    size_t numTasks = 0;
+    size_t nextTaskIndex = 0;
+    size_t numTasksFinished = 0;
+    bool stopping = false;
+
+    void work();
+
+ public:
+    explicit ThreadPool(const size_t numThreads);
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    ~ThreadPool();
+    void run(const size_t newNumTasks, const std::function<void(const size_t)>& newTask);
+};
@@ -17,12 +17,16 @@
 #include <map>
 #include <ctime>
 #include <algorithm>
+#include <ostream>
 #ifdef _WIN32
 #include <cstdlib>
 #endif
 /* internal libraries */
+#include "file-reader/ODMatrix.hpp"
 #include "simulator/Ambulance.hpp"
+#include "simulator/AvailabilityIndex.hpp"
 #include "simulator/Event.hpp"
+#include "simulator/SimulationConfig.hpp"
 #include "simulator/strategies/DispatchEngineStrategyType.hpp"
 #include "heuristics/CrossoverType.hpp"
 #include "heuristics/ObjectiveTypes.hpp"
@@ -61,37 +65,26 @@ ObjectiveTypes stringToObjectiveType(const std::string& str);
 std::string tmToString(const std::tm& time);
 std::string valueTypeToString(const ValueType& cell);
 double timeDifferenceInSeconds(std::tm& time1, std::tm& time2);
-std::vector<unsigned> getAvailableAmbulanceIndicies(
-    std::vector<Ambulance>& ambulances,
-    const std::vector<Event>& events,
-    const time_t& currentTime,
-    const std::string& currentEventTriageImpression
-);
-int calculateDayDifference(const std::tm& baseDate, const int targetMonth, const int targetDay);
+bool isLeapYear(const int year);
+int dayOfYear(const int year, const int month, const int day);
+int calculateDayDifference(const int baseYear, const int baseDayOfYear, const int targetMonth, const int targetDay);
 int weightedLottery(
     std::mt19937& rnd,
     const std::vector<double>& weights,
     const std::vector<std::pair<int, int>>& ranges = {}
 );
-int getRandomInt(std::mt19937& rnd, int min, int max);
 double getRandomDouble(std::mt19937& rnd, const double min = 0.0, const double max = 1.0);
 bool getRandomBool(std::mt19937& rnd);
+int getNumThreads();
 double calculateMean(const std::vector<int>& numbers);
 double calculateStandardDeviation(const std::vector<int>& numbers);
 double calculateEuclideanDistance(const double x1, const double y1, const double x2, const double y2);
 std::pair<int, int> idToUtm(const int64_t& grid_id);
 int64_t utmToId(const std::pair<int, int>& utm, const int cellSize = 1000, const int offset = 2000000);
-int64_t approximateLocation(
-    std::mt19937& rnd,
-    const int64_t& startId,
-    const int64_t& goalId,
-    const time_t& timeAtStart,
-    const time_t& timeNow,
-    const std::string& triage,
-    const EventType eventType
-);
 int findEventIndexFromId(const std::vector<Event>& events, const int id);
 void writeEvents(const std::string& dirName, std::vector<Event>& events, std::string fileName = "events");
+void writeEventsHeader(std::ostream& outStream);
+void writeEvent(std::ostream& outStream, const Event& event);
 void writeGenotype(const std::string& dirName, const std::vector<std::vector<int>>& genotype, std::string fileName = "genotype");
 void writeAmbulances(const std::string& dirName, const std::vector<Ambulance>& ambulances, std::string fileName = "ambulances");
 void saveDistributionToFile(const std::vector<std::vector<double>>& distribution, const std::string& baseFilename);
@@ -111,6 +104,11 @@ double responseTimeViolations(
     const int allocationIndex = -1,
     const int depotIndex = -1
 );
+std::vector<double> responseTimeViolationsPerDepot(
+    std::vector<Event>& simulatedEvents,
+    const int allocationIndex,
+    const int numDepots
+);
 double responseTimeViolationsUrban(
     std::vector<Event>& simulatedEvents,
     const bool checkUrban,
@@ -148,9 +146,117 @@ int findIndex(const std::vector<T>& vec, const T& value) {
     }
 }
 
-template <typename T>
-T getRandomElement(std::mt19937& rnd, const std::vector<T>& vec) {
+inline uint64_t splitMix64(uint64_t value) {
+    // mixes all bits of the input, used to derive independent seeds from counters
+    value += 0x9E3779B97F4A7C15ULL;
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+
+    return value ^ (value >> 31);
+}
+
+// key of a random number stream derived from the key of the stream it belongs to, for common random numbers
+inline uint64_t deriveStreamKey(const uint64_t parentKey, const uint64_t value) {
+    return splitMix64(parentKey ^ splitMix64(value));
+}
+
+template <typename Random>
+int getRandomInt(Random& rnd, int min, int max) {
+    if (min > max) {
+        int tmp = min;
+        min = max;
+        max = tmp;
+    }
+
+    std::uniform_int_distribution<> dist(min, max);
+
+    return dist(rnd);
+}
+
+template <typename T, typename Random>
+T getRandomElement(Random& rnd, const std::vector<T>& vec) {
     std::uniform_int_distribution<int> rndBetween(0, static_cast<int>(vec.size()) - 1);
 
     return vec[rndBetween(rnd)];
 }
+
+template <typename Policy>
+void getAvailableAmbulanceIndicies(
+    std::vector<unsigned>& availableAmbulanceIndicies,
+    std::vector<Ambulance>& ambulances,
+    const AvailabilityIndex& availabilityIndex,
+    const std::string& currentEventTriageImpression
+) {
+    // fills the given buffer so its memory is reused between events
+    availableAmbulanceIndicies.clear();
+
+    // only ambulances that are idle or travelling can be picked, busy ones and ones on break are skipped
+    const AmbulanceState candidateStates[] = {
+        AmbulanceState::IDLE,
+        AmbulanceState::DISPATCHING_TO_DEPOT,
+        AmbulanceState::DISPATCHING_TO_SCENE
+    };
+    const int numCandidateStates = Policy::prioritizeTriage ? 3 : 2;
+
+    // populates pool with available ambulances, the state stands in for the assigned event so no event is looked up
+    for (int stateIndex = 0; stateIndex < numCandidateStates; stateIndex++) {
+        for (const int i : availabilityIndex.getAmbulances(candidateStates[stateIndex])) {
+            // check with ambulance if it is available
+            if (ambulances[i].isAvailable<Policy>(candidateStates[stateIndex], currentEventTriageImpression)) {
+                availableAmbulanceIndicies.push_back(i);
+            }
+        }
+    }
+
+    // keep the order of the fleet so the pool doesn't depend on the order of state changes
+    std::sort(availableAmbulanceIndicies.begin(), availableAmbulanceIndicies.end());
+}
+
+template <typename Random>
+int64_t approximateLocation(
+    Random& rnd,
+    const int64_t& startId,
+    const int64_t& goalId,
+    const time_t& timeAtStart,
+    const time_t& timeNow,
+    const std::string& triage,
+    const EventType eventType
+) {
+    // if ambulance is dispatching to depot, apply traffic, otherwise check triage
+    bool forceTrafficFactor = true;
+    if (eventType == EventType::DISPATCHING_TO_SCENE) {
+        forceTrafficFactor = false;
+    }
+
+    int timeToReachGoal = ODMatrix::getInstance().getTravelTime(
+        rnd,
+        startId,
+        goalId,
+        forceTrafficFactor,
+        triage,
+        timeAtStart
+    );
+
+    // use interpolation to find approximate location
+    time_t timeTravelled = timeNow - timeAtStart;
+
+    double proportion = static_cast<double>(timeTravelled) / static_cast<double>(timeToReachGoal);
+
+    std::pair<int, int> utmStart = idToUtm(startId);
+    std::pair<int, int> utmGoal = idToUtm(goalId);
+
+    std::pair<int, int> utmInterpolated = {
+        static_cast<int>(static_cast<double>(utmStart.first) + static_cast<double>(utmGoal.first - utmStart.first) * proportion),
+        static_cast<int>(static_cast<double>(utmStart.second) + static_cast<double>(utmGoal.second - utmStart.second) * proportion)
+    };
+
+    int64_t approximatedGridId = utmToId(utmInterpolated);
+
+    /*std::cout
+        << startId << " -> " << goalId << " = " << approximatedGridId << " ("
+        << proportion * 100 << "% ("
+        << timeTravelled << "->" << timeToReachGoal
+        << "))" << std::endl;*/
+
+    return approximatedGridId;
+}
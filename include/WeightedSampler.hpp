@@ -0,0 +1,29 @@
+/**
+ * @file WeightedSampler.hpp
+ *
+ * @copyright Copyright (c) 2024 Emergency-Optimizers
+ */
+
+#pragma once
+
+/* external libraries */
+#include <random>
+#include <utility>
+#include <vector>
+
+// weighted lottery over a fixed set of weights, cumulative weights are built once and reused for every draw
+class WeightedSampler {
+ private:
+    int numWeights = 0;
+    std::vector<double> cumulativeWeights;
+    // index into the original weights of each cumulative weight, empty if the full weights vector is used
+    std::vector<int> originalIndices;
+
+ public:
+    WeightedSampler() = default;
+    explicit WeightedSampler(
+        const std::vector<double>& weights,
+        const std::vector<std::pair<int, int>>& ranges = {}
+    );
+    int sample(std::mt19937& rnd) const;
+};
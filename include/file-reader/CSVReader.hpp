@@ -28,8 +28,18 @@ class CSVReader {
     void print();
     void printRow(const int index);
 
+    int getColumnIndex(const std::string& header) const {
+        return findIndex(headers, header);
+    }
+
     template <typename T>
     T get(const std::string& header, const int index) const {
         return std::get<T>(rows[index][findIndex(headers, header)]);
     }
+
+    // lookup by column index from getColumnIndex, avoids the header search in loops over many rows
+    template <typename T>
+    T get(const int columnIndex, const int index) const {
+        return std::get<T>(rows[index][columnIndex]);
+    }
 };
@@ -7,25 +7,51 @@
 #pragma once
 
 /* external libraries */
+#include <cstdint>
+#include <map>
 #include <string>
+#include <utility>
 #include <vector>
-#include <map>
 /* internal libraries */
 #include "file-reader/CSVReader.hpp"
 
 class Incidents : public CSVReader {
  private:
+    // urbanization of each 1 km grid cell within the bounding box of all incidents
+    const int cellSize = 1000;
+    int minEasting = 0;
+    int minNorthing = 0;
+    int numCellsEasting = 0;
+    int numCellsNorthing = 0;
+    std::vector<bool> urbanCells;
+    // calendar year and 0 based day of year of each incident's call, computed once at load
+    std::vector<int> callYears;
+    std::vector<int> callDaysOfYear;
+    // first incident of each (year, day of year)
+    std::map<std::pair<int, int>, int> firstIndexOfDay;
+
     Incidents();
+    int getCellIndex(const int64_t& gridId) const;
 
  public:
-    std::map<int64_t, bool> gridIdUrban;
-
     Incidents(const Incidents&) = delete;
     Incidents& operator=(const Incidents&) = delete;
     static Incidents& getInstance() {
         static Incidents instance;
         return instance;
     }
+    // hard coded path, important to follow steps in README.md to be able to run
+    static std::string getFilename() {
+        return "../../Data-Processing/data/enhanced/oslo/incidents.csv";
+    }
+    bool isUrban(const int64_t& gridId) const;
+    int getCallYear(const int index) const {
+        return callYears[index];
+    }
+    int getCallDayOfYear(const int index) const {
+        return callDaysOfYear[index];
+    }
+    int getFirstIndexOfDay(const int year, const int dayOfYear) const;
     double timeDifferenceBetweenHeaders(const std::string& header1, const std::string& header2, const int index);
     std::vector<int> rowsWithinTimeFrame(const int month, const int day, const int windowSize);
 };
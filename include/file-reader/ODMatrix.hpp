@@ -7,6 +7,7 @@
 #pragma once
 
 /* external libraries */
+#include <cmath>
 #include <string>
 #include <vector>
 #include <unordered_map>
@@ -18,7 +19,6 @@ class ODMatrix {
     std::unordered_map<int64_t, int> idToIndexMap;
     const double noiseMean = 1.0;
     const double noiseStddev = 0.02;
-    std::normal_distribution<> normalDist = std::normal_distribution<>(noiseMean, noiseStddev);
 
     ODMatrix();
     void loadFromFile(const std::string& filename);
@@ -30,8 +30,16 @@ class ODMatrix {
         static ODMatrix instance;
         return instance;
     }
+    double getExpectedTravelTime(
+        const int64_t& id1,
+        const int64_t& id2,
+        const bool forceTrafficFactor,
+        const std::string& triage,
+        const time_t& time
+    );
+    template <typename Random>
     int getTravelTime(
-        std::mt19937& rnd,
+        Random& rnd,
         const int64_t& id1,
         const int64_t& id2,
         const bool forceTrafficFactor,
@@ -39,4 +47,40 @@ class ODMatrix {
         const time_t& time
     );
     bool gridIdExists(const int64_t& id);
+    // number of travel time lookups made by the calling thread, only counted while enabled for the thread
+    static int64_t& travelTimeCalls() {
+        static thread_local int64_t calls = 0;
+        return calls;
+    }
+    static bool& countTravelTimeCalls() {
+        static thread_local bool enabled = false;
+        return enabled;
+    }
 };
+
+template <typename Random>
+int ODMatrix::getTravelTime(
+    Random& rnd,
+    const int64_t& id1,
+    const int64_t& id2,
+    const bool forceTrafficFactor,
+    const std::string& triage,
+    const time_t& time
+) {
+    if (countTravelTimeCalls()) {
+        travelTimeCalls()++;
+    }
+
+    double travelTime = getExpectedTravelTime(id1, id2, forceTrafficFactor, triage, time);
+    if (travelTime < 0.0) {
+        return 0;
+    }
+
+    // add noise, the distribution is not kept between calls as it caches every other sample
+    // which would make travel times depend on more than the state of rnd
+    std::normal_distribution<> normalDist(noiseMean, noiseStddev);
+    double noise = normalDist(rnd);
+    travelTime *= noise;
+
+    return static_cast<int>(floor(travelTime));
+}
@@ -78,6 +78,15 @@ class Settings {
         {"SURVIVOR_SELECTION_KEEP_N_BEST", &toInt},
         {"DISPATCH_STRATEGY_PRIORITIZE_TRIAGE", &toBool},
         {"SCHEDULE_BREAKS", &toBool},
+        {"COMMON_RANDOM_NUMBERS", &toBool},
+        {"NUM_SCENARIOS", &toInt},
+        {"SCENARIO_STOPPING_Z_SCORE", &toDouble},
+        {"NUM_THREADS", &toInt},
+        {"TRACE_BUFFER_SIZE", &toInt},
+        {"COLLECT_STATS", &toBool},
+        {"SCENARIO_CACHE", &toBool},
+        {"STREAM_EVENTS", &toBool},
+        {"ROLLING_HORIZON_DAYS", &toInt},
         {"OBJECTIVES", &toVectorObjectiveType},
         {"UNIQUE_RUN_ID", &toString},
         {"STOPPING_CRITERIA_TIME_MIN", &toFloat},
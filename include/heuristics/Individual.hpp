@@ -7,21 +7,34 @@
 #pragma once
 
 /* external libraries */
+#include <array>
 #include <vector>
 #include <numeric>
 #include <random>
 #include <string>
+#include <memory>
 /* internal libraries */
 #include "simulator/Event.hpp"
 #include "simulator/Ambulance.hpp"
+#include "simulator/Simulator.hpp"
 #include "simulator/strategies/DispatchEngineStrategyType.hpp"
 #include "heuristics/GenotypeInitType.hpp"
 #include "heuristics/MutationType.hpp"
 #include "file-reader/Settings.hpp"
 #include "heuristics/ObjectiveTypes.hpp"
+#include "heuristics/ObjectiveAccumulator.hpp"
+#include "WeightedSampler.hpp"
+#include "ThreadPool.hpp"
 
 class Individual {
  private:
+    // objective values of one scenario in the order of ObjectiveTypes, for the whole shift and each time segment
+    struct ScenarioObjectives {
+        double fitness = 0.0;
+        std::array<double, NUM_OBJECTIVE_TYPES> objectives;
+        std::vector<std::array<double, NUM_OBJECTIVE_TYPES>> allocationsObjectives;
+    };
+
     std::mt19937& rnd;
     int numAmbulances;
     int numAllocations;
@@ -31,7 +44,7 @@ class Individual {
         const bool isChild,
         const bool dayShift,
         const std::vector<GenotypeInitType>& inits,
-        const std::vector<double>& tickets
+        const WeightedSampler& genotypeInitsSampler
     );
     void emptyGenotype();
     void randomGenotype();
@@ -41,12 +54,26 @@ class Individual {
     void swapMutation(const double mutationProbability);
     void scrambleMutation(const double mutationProbability);
     void neighborDuplicationMutation(const double mutationProbability);
+    std::shared_ptr<const SimulationCheckpoint> getCheckpoint(const int allocationIndex) const;
+    int getResumeAllocationIndex(const Individual& parent) const;
+    void simulateScenario(const std::vector<Event>& events, Simulator& simulator, ScenarioObjectives& sample) const;
+    void averageObjectives(const std::vector<ScenarioObjectives>& samples, const size_t numSamples);
+    void readObjectives(const ObjectiveAccumulator& accumulator, ScenarioObjectives& values) const;
+    void getObjectives(ScenarioObjectives& values) const;
+    void setObjectives(const ScenarioObjectives& values);
+    double getWeightedFitness(const std::array<double, NUM_OBJECTIVE_TYPES>& values) const;
+    void updateObjectives();
     void updateMetrics();
 
  public:
     std::vector<std::vector<int>> genotype;
     std::vector<Event> simulatedEvents;
     std::vector<Ambulance> simulatedAmbulances;
+    // simulator state at the start of the last time segment, earlier segments are reached through its chain.
+    // checkpoints are immutable and shared with offspring
+    std::shared_ptr<const SimulationCheckpoint> checkpoint;
+    // number of Monte Carlo scenarios the objectives are averaged over
+    int numScenariosEvaluated = 1;
 
     double weightAvgResponseTimeUrbanA = Settings::get<double>("OBJECTIVE_WEIGHT_AVG_RESPONSE_TIME_URBAN_A");
     double weightAvgResponseTimeUrbanH = Settings::get<double>("OBJECTIVE_WEIGHT_AVG_RESPONSE_TIME_URBAN_H");
@@ -94,13 +121,22 @@ class Individual {
         const bool isChild,
         const bool dayShift,
         const std::vector<GenotypeInitType>& genotypeInits,
-        const std::vector<double>& genotypeInitsTickets
+        const WeightedSampler& genotypeInitsSampler
+    );
+    void evaluate(const std::vector<Event>& events, Simulator& simulator);
+    void evaluate(const std::vector<Event>& events, Simulator& simulator, const std::vector<Individual>& parents);
+    void evaluate(const std::vector<Event>& events, Simulator& simulator, const Individual& parent);
+    void evaluateScenarios(
+        const std::vector<std::vector<Event>>& scenarios,
+        std::vector<Simulator>& simulators,
+        ThreadPool& threadPool,
+        const double fitnessThreshold,
+        const double stoppingZScore
     );
-    void evaluate(std::vector<Event> events, const bool dayShift, const DispatchEngineStrategyType dispatchStrategy);
     void mutate(
         const double mutationProbability,
         const std::vector<MutationType>& mutations,
-        const std::vector<double>& tickets
+        const WeightedSampler& mutationsSampler
     );
     void repair();
     bool isValid() const;
@@ -117,6 +153,8 @@ class Individual {
             genotype = other.genotype;
             simulatedEvents = other.simulatedEvents;
             simulatedAmbulances = other.simulatedAmbulances;
+            checkpoint = other.checkpoint;
+            numScenariosEvaluated = other.numScenariosEvaluated;
             weightAvgResponseTimeUrbanA = other.weightAvgResponseTimeUrbanA;
             weightAvgResponseTimeUrbanH = other.weightAvgResponseTimeUrbanH;
             weightAvgResponseTimeUrbanV1 = other.weightAvgResponseTimeUrbanV1;
@@ -0,0 +1,45 @@
+/**
+ * @file ObjectiveAccumulator.hpp
+ *
+ * @copyright Copyright (c) 2024 Emergency-Optimizers
+ */
+
+#pragma once
+
+/* external libraries */
+#include <cstdint>
+#include <string>
+#include <vector>
+/* internal libraries */
+#include "simulator/Event.hpp"
+
+// bins simulated events by time segment, triage and urbanization in one pass, objectives are read from the bins
+class ObjectiveAccumulator {
+ private:
+    struct Bin {
+        int64_t totalResponseTime = 0;
+        int totalEvents = 0;
+        int totalViolations = 0;
+    };
+
+    // A, H, V1 and any other triage impression
+    static const int NUM_TRIAGES = 4;
+    static const int TRIAGE_V1 = 2;
+
+    // segment slot 0 holds events outside the time segments, they only count towards the totals
+    int numAllocations = 0;
+    std::vector<Bin> bins;
+
+    static int getTriageIndex(const std::string& triageImpression);
+    int getBinIndex(const int segmentSlot, const int triageIndex, const bool urban) const;
+    Bin sumBins(const int allocationIndex, const int triageIndex, const bool urban) const;
+    double violations(const int allocationIndex, const bool countUrban, const bool countRural) const;
+
+ public:
+    void reset(const int newNumAllocations);
+    void accumulate(const std::vector<Event>& simulatedEvents);
+    void accumulate(const Event& event);
+    double averageResponseTime(const std::string& triageImpression, const bool urban, const int allocationIndex = -1) const;
+    double responseTimeViolations(const int allocationIndex = -1) const;
+    double responseTimeViolationsUrban(const bool checkUrban, const int allocationIndex = -1) const;
+};
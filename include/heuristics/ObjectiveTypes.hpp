@@ -6,6 +6,9 @@
 
 #pragma once
 
+/* external libraries */
+#include <cstddef>
+
 enum class ObjectiveTypes {
     AVG_RESPONSE_TIME_URBAN_A,
     AVG_RESPONSE_TIME_URBAN_H,
@@ -17,3 +20,5 @@ enum class ObjectiveTypes {
     PERCENTAGE_VIOLATIONS_URBAN,
     PERCENTAGE_VIOLATIONS_RURAL,
 };
+
+const size_t NUM_OBJECTIVE_TYPES = static_cast<size_t>(ObjectiveTypes::PERCENTAGE_VIOLATIONS_RURAL) + 1;
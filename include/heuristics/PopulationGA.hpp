@@ -21,21 +21,27 @@
 #include "file-reader/Stations.hpp"
 #include "file-reader/ODMatrix.hpp"
 #include "simulator/Event.hpp"
+#include "simulator/SimulationConfig.hpp"
 #include "heuristics/GenotypeInitType.hpp"
 #include "heuristics/MutationType.hpp"
 #include "heuristics/CrossoverType.hpp"
 #include "heuristics/SelectionType.hpp"
+#include "WeightedSampler.hpp"
+#include "ThreadPool.hpp"
+
+// default for heuristics without additional scenarios, populations only keep a reference to their scenarios
+inline const std::vector<std::vector<Event>> NO_SCENARIOS;
 
 class PopulationGA {
  private:
     std::vector<GenotypeInitType> genotypeInits;
-    std::vector<double> genotypeInitsTickets;
+    WeightedSampler genotypeInitsSampler;
     std::vector<CrossoverType> crossovers;
-    std::vector<double> crossoversTickets;
+    WeightedSampler crossoversSampler;
     std::vector<SelectionType> parentSelections;
-    std::vector<double> parentSelectionsTickets;
+    WeightedSampler parentSelectionsSampler;
     std::vector<SelectionType> survivorSelections;
-    std::vector<double> survivorSelectionsTickets;
+    WeightedSampler survivorSelectionsSampler;
 
     void generatePopulation();
     void getPossibleGenotypeInits();
@@ -84,6 +90,8 @@ class PopulationGA {
  protected:
     std::mt19937 rnd = std::mt19937(Settings::get<int>("SEED"));
     const std::vector<Event>& events;
+    // additional scenarios to average objectives over, evaluated in parallel with one simulator per thread
+    const std::vector<std::vector<Event>>& scenarios;
     std::vector<Individual> individuals;
     int generation = 0;
     const bool dayShift = Settings::get<bool>("SIMULATE_DAY_SHIFT");
@@ -92,11 +100,16 @@ class PopulationGA {
     const int numAmbulances = dayShift ?
         Settings::get<int>("TOTAL_AMBULANCES_DURING_DAY") : Settings::get<int>("TOTAL_AMBULANCES_DURING_NIGHT");
     const int numTimeSegments = Settings::get<int>("NUM_TIME_SEGMENTS");
-    const DispatchEngineStrategyType dispatchStrategy = Settings::get<DispatchEngineStrategyType>("DISPATCH_STRATEGY");
+    const SimulationConfig config = SimulationConfig::fromSettings();
+    Simulator simulator = Simulator(config);
+    std::vector<Simulator> scenarioSimulators = std::vector<Simulator>(scenarios.empty() ? 0 : getNumThreads(), simulator);
+    // started once and reused for every batch of scenarios
+    ThreadPool scenarioThreadPool = ThreadPool(scenarioSimulators.size());
+    const double scenarioStoppingZScore = Settings::get<double>("SCENARIO_STOPPING_Z_SCORE");
     const double crossoverProbability = Settings::get<float>("CROSSOVER_PROBABILITY");
     const double mutationProbability = Settings::get<float>("MUTATION_PROBABILITY");
     std::vector<MutationType> mutations;
-    std::vector<double> mutationsTickets;
+    WeightedSampler mutationsSampler;
     const std::string heuristicName = "GA";
     double bestVioUrban = 1.0;
     double bestVioRural = 1.0;
@@ -132,8 +145,10 @@ class PopulationGA {
     virtual void storeGenerationMetrics();
     int countUnique() const;
     bool shouldStop();
+    virtual double getScenarioFitnessThreshold(const std::vector<Individual>& offspring) const;
+    void writeStats(const std::string& dirName, const std::string& fileName) const;
 
  public:
-    explicit PopulationGA(const std::vector<Event>& events);
+    explicit PopulationGA(const std::vector<Event>& events, const std::vector<std::vector<Event>>& scenarios = NO_SCENARIOS);
     virtual void evolve(const bool verbose = true, std::string extraFileName = "");
 };
@@ -25,5 +25,5 @@ class PopulationMA : virtual public PopulationGA {
     const std::string getHeuristicName() const override;
 
  public:
-    explicit PopulationMA(const std::vector<Event>& events);
+    explicit PopulationMA(const std::vector<Event>& events, const std::vector<std::vector<Event>>& scenarios = NO_SCENARIOS);
 };
@@ -27,6 +27,9 @@ class PopulationMemeticNSGA2 : public PopulationNSGA2, public PopulationMA {
     using PopulationNSGA2::storeGenerationMetrics;
 
  public:
-    explicit PopulationMemeticNSGA2(const std::vector<Event>& events);
+    explicit PopulationMemeticNSGA2(
+        const std::vector<Event>& events,
+        const std::vector<std::vector<Event>>& scenarios = NO_SCENARIOS
+    );
     using PopulationNSGA2::evolve;
 };
@@ -45,8 +45,9 @@ class PopulationNSGA2 : virtual public PopulationGA {
     const std::string getProgressBarPostfix() const override;
     void storeGenerationMetrics() override;
     const std::string getHeuristicName() const override;
+    double getScenarioFitnessThreshold(const std::vector<Individual>& offspring) const override;
 
  public:
-    explicit PopulationNSGA2(const std::vector<Event>& events);
+    explicit PopulationNSGA2(const std::vector<Event>& events, const std::vector<std::vector<Event>>& scenarios = NO_SCENARIOS);
     void evolve(const bool verbose = true, std::string extraFileName = "") override;
 };
@@ -11,7 +11,9 @@
 #include <string>
 /* internal libraries */
 #include "simulator/Event.hpp"
+#include "simulator/MonteCarloSimulator.hpp"
 
+std::vector<std::vector<int>> getSimplifiedOUHAllocations(const bool dayShift);
 void runSimulatorOnce(
     std::vector<Event>& events,
     const bool verbose = true,
@@ -19,10 +21,23 @@ void runSimulatorOnce(
     std::vector<std::vector<int>> allocations = {},
     std::string extraFileName = ""
 );
-void runGeneticAlgorithm(const std::vector<Event>& events);
-void runNSGA2(const std::vector<Event>& events);
-void runMemeticAlgorithm(const std::vector<Event>& events);
-void runMemeticNSGA2(const std::vector<Event>& events);
+void runSimulatorStreamed(
+    const MonteCarloSimulator& monteCarloSimulator,
+    const bool verbose = true,
+    const bool saveToFile = true,
+    std::vector<std::vector<int>> allocations = {}
+);
+void runRollingHorizon(
+    const int numDays,
+    const bool verbose = true,
+    const bool saveToFile = true,
+    std::vector<std::vector<int>> dayShiftAllocations = {},
+    std::vector<std::vector<int>> nightShiftAllocations = {}
+);
+void runGeneticAlgorithm(const std::vector<Event>& events, const std::vector<std::vector<Event>>& scenarios = {});
+void runNSGA2(const std::vector<Event>& events, const std::vector<std::vector<Event>>& scenarios = {});
+void runMemeticAlgorithm(const std::vector<Event>& events, const std::vector<std::vector<Event>>& scenarios = {});
+void runMemeticNSGA2(const std::vector<Event>& events, const std::vector<std::vector<Event>>& scenarios = {});
 void runTimeEvaluation();
 void runDataValidation(std::vector<Event>& events);
 void runSimulationGridSearch(const std::vector<Event>& events);
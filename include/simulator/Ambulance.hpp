@@ -9,8 +9,13 @@
 /* external libraries */
 #include <vector>
 #include <string>
+#include <utility>
 /* internal libraries */
 #include "simulator/Event.hpp"
+#include "simulator/AmbulanceState.hpp"
+#include "simulator/AvailabilityIndex.hpp"
+#include "simulator/SimulationConfig.hpp"
+
 
 struct Ambulance {
     int id = -1;
@@ -19,25 +24,60 @@ struct Ambulance {
     int assignedEventId = -1;
     int timeUnavailable = 0;
     int timeNotWorking = 0;
-    time_t timeBreakStarted = 0;
-    int breakLength = 0;
-    std::vector<time_t> scheduledBreaks;
+    int pendingBreaks = 0;
     int currentAllocationIndex = 0;
+    // triage of the event the ambulance is dispatched to, set when it starts travelling to the scene
+    std::string sceneTriageImpression;
+    AvailabilityIndex* availabilityIndex = nullptr;
 
-    void checkScheduledBreak(const time_t& currentTime);
-    void setBreak(const int newBreakLength, const time_t& currentTime);
-    bool isAvailable(
-        const std::vector<Event>& events,
-        const std::vector<Ambulance>& ambulances,
-        const int eventIndex,
-        const time_t& currentTime,
-        const std::string& currentEventTriageImpression
-    );
-    void scheduleBreaks(
+    void setState(const AmbulanceState state);
+    void reallocate(const int depotIndex);
+    template <typename Policy>
+    bool isAvailable(const AmbulanceState state, const std::string& currentEventTriageImpression) const;
+    std::pair<time_t, time_t> getBreakTimes(
         const time_t& shiftStart,
         const time_t& shiftEnd,
         const int depotSize,
         const int depotNum
-    );
-    bool higherTriagePriority(const std::string& triage, const std::string& triageToCompare);
+    ) const;
+    bool higherTriagePriority(const std::string& triage, const std::string& triageToCompare) const;
 };
+
+template <typename Policy>
+bool Ambulance::isAvailable(const AmbulanceState state, const std::string& currentEventTriageImpression) const {
+    // if the ambulance is due a break it will take it when back at depot, so it can't be picked before that
+    if (Policy::scheduleBreaks && assignedEventId != -1 && pendingBreaks > 0) {
+        return false;
+    }
+
+    // if this is the only available ambulance in the depot and Strategic Resorve policy is used
+    if (assignedEventId == -1 && currentEventTriageImpression == "A" && Policy::responseRestricted) {
+        // idle count includes this ambulance
+        const bool onlyAvailableAmbulance = availabilityIndex->getIdleInDepot(allocatedDepotIndex) <= 1;
+
+        if (onlyAvailableAmbulance) {
+            return false;
+        }
+    }
+
+    // if ambulance is not assigned to an event
+    if (assignedEventId == -1) {
+        return true;
+    }
+
+    // if ambulance is returing to depot, the state follows the type of the assigned event
+    if (state == AmbulanceState::DISPATCHING_TO_DEPOT) {
+        return true;
+    }
+
+    // if ambulance is dispatching to scene and Dynamic Reassignment policy is used
+    if (state == AmbulanceState::DISPATCHING_TO_SCENE) {
+        bool shouldPrioritizeHigherTriage = Policy::prioritizeTriage;
+        bool eventIsHigherTriage =  higherTriagePriority(currentEventTriageImpression, sceneTriageImpression);
+        if (shouldPrioritizeHigherTriage && eventIsHigherTriage) {
+            return true;
+        }
+    }
+
+    return false;
+}
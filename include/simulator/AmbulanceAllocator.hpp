@@ -10,18 +10,38 @@
 #include <vector>
 /* internal libraries */
 #include "simulator/Ambulance.hpp"
+#include "simulator/AvailabilityIndex.hpp"
 #include "simulator/Event.hpp"
+#include "simulator/SimulationConfig.hpp"
 
 class AmbulanceAllocator {
  private:
-    void allocateAndScheduleBreaks(const time_t& shiftStart, const time_t& shiftEnd);
+    std::vector<int> depotAmbulanceCounts;
+    std::vector<int> depotAmbulanceOrdered;
+
+    void allocateAndScheduleBreaks(
+        std::vector<Event>& events,
+        const SimulationConfig& config,
+        const std::vector<int>& allocation,
+        const std::vector<unsigned>& depotIndices,
+        const time_t& shiftStart,
+        const time_t& shiftEnd
+    );
 
  public:
     std::vector<Ambulance> ambulances;
+    AvailabilityIndex availabilityIndex;
+    std::vector<std::vector<int>> genotype;
 
     void allocate(
         std::vector<Event>& events,
         const std::vector<std::vector<int>>& allocations,
-        const bool dayshift
+        const SimulationConfig& config
+    );
+    void scheduleShift(
+        std::vector<Event>& events,
+        const std::vector<std::vector<int>>& allocations,
+        const SimulationConfig& config,
+        const time_t& shiftStart
     );
 };
@@ -0,0 +1,15 @@
+/**
+ * @file AmbulanceState.hpp
+ *
+ * @copyright Copyright (c) 2024 Emergency-Optimizers
+ */
+
+#pragma once
+
+enum class AmbulanceState {
+    IDLE,
+    ON_BREAK,
+    DISPATCHING_TO_SCENE,
+    DISPATCHING_TO_DEPOT,
+    BUSY
+};
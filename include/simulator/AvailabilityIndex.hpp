@@ -0,0 +1,30 @@
+/**
+ * @file AvailabilityIndex.hpp
+ *
+ * @copyright Copyright (c) 2024 Emergency-Optimizers
+ */
+
+#pragma once
+
+/* external libraries */
+#include <vector>
+/* internal libraries */
+#include "simulator/AmbulanceState.hpp"
+
+class AvailabilityIndex {
+ private:
+    std::vector<std::vector<int>> ambulancesInState;
+    std::vector<AmbulanceState> states;
+    std::vector<int> positions;
+    // depot of each ambulance and number of idle ambulances per depot, used by the strategic reserve policy
+    std::vector<int> depots;
+    std::vector<int> idleInDepot;
+
+ public:
+    void reset(const int numAmbulances);
+    void setState(const int ambulanceIndex, const AmbulanceState state);
+    void setDepot(const int ambulanceIndex, const int depotIndex);
+    AmbulanceState getState(const int ambulanceIndex) const;
+    const std::vector<int>& getAmbulances(const AmbulanceState state) const;
+    int getIdleInDepot(const int depotIndex) const;
+};
@@ -0,0 +1,24 @@
+/**
+ * @file DurationType.hpp
+ *
+ * @copyright Copyright (c) 2024 Emergency-Optimizers
+ */
+
+#pragma once
+
+/* external libraries */
+#include <cstddef>
+
+// delays sampled from KDEs when generating events
+enum class DurationType {
+    WAIT_CALL_ANSWERED,
+    WAIT_APPOINTING_RESOURCE,
+    WAIT_RESOURCE_PREPARING_DEPARTURE,
+    WAIT_DEPARTURE_SCENE,
+    WAIT_AVAILABLE,
+    // time at scene until available for incidents that never went to a hospital
+    WAIT_AVAILABLE_CANCELLED,
+    NONE
+};
+
+const size_t NUM_DURATION_TYPES = static_cast<size_t>(DurationType::NONE);
@@ -8,11 +8,12 @@
 
 /* external libraries */
 #include <string>
-#include <map>
-#include <vector>
+#include <array>
+#include <cstdint>
 #include <ctime>
 /* internal libraries */
 #include "simulator/EventType.hpp"
+#include "simulator/EventMetric.hpp"
 
 // pre defined for avoiding cyclic imports
 struct Ambulance;
@@ -20,21 +21,14 @@ struct Ambulance;
 struct Event {
     int id = -1;
     EventType type = EventType::RESOURCE_APPOINTMENT;
+    // timers are seconds relative to the SimClock epoch
     std::time_t timer;
     std::time_t prevTimer = 0;
     Ambulance* assignedAmbulance = nullptr;
-    std::map<std::string, int> metrics = {
-        {"duration_incident_creation", -1},
-        {"duration_resource_appointment", -1},
-        {"duration_resource_preparing_departure", -1},
-        {"duration_dispatching_to_scene", -1},
-        {"duration_at_scene", -1},
-        {"duration_dispatching_to_hospital", -1},
-        {"duration_at_hospital", -1},
-        {"duration_dispatching_to_depot", -1},
-    };
+    // indexed by EventMetric, -1 if not set
+    std::array<int, NUM_EVENT_METRICS> metrics = {-1, -1, -1, -1, -1, -1, -1, -1};
     std::string triageImpression;
-    std::tm callReceived;
+    std::time_t callReceived = 0;
     double secondsWaitCallAnswered = -1.0;
     double secondsWaitAppointingResource = -1.0;
     double secondsWaitResourcePreparingDeparture = -1.0;
@@ -42,14 +36,24 @@ struct Event {
     double secondsWaitAvailable = -1.0;
     int64_t gridId = -1LL;
     int64_t incidentGridId = -1LL;
+    // urbanization of the incident location, resolved when the event is generated
+    bool urban = false;
     int depotIndexResponsible = -1;
     int ambulanceIdResponsible = -1;
+    // time segment of the genotype the event was handled in, or the segment to switch to for reallocation events
     int allocationIndex = -1;
-    std::vector<int> reallocation;
     bool utility = false;
+    // genotype independent key of the event's random number stream in common random numbers mode
+    uint64_t randomStreamKey = 0;
+    // times in a row the event was processed without changing type, each retry draws from its own stream
+    int retries = 0;
 
-    void updateTimer(const int increment, const std::string& metric = "", const bool dontUpdateTimer = false);
-    int getResponseTime();
+    void setType(const EventType newType);
+    void updateTimer(const int increment, const EventMetric metric = EventMetric::NONE, const bool dontUpdateTimer = false);
+    int& getMetric(const EventMetric metric);
+    int getMetric(const EventMetric metric) const;
+    int getResponseTime() const;
     void removeAssignedAmbulance();
     void assignAmbulance(Ambulance& ambulance);
+    void updateAmbulanceState();
 };
@@ -0,0 +1,47 @@
+/**
+ * @file EventGenerator.hpp
+ *
+ * @copyright Copyright (c) 2024 Emergency-Optimizers
+ */
+
+#pragma once
+
+/* external libraries */
+#include <ctime>
+#include <random>
+#include <vector>
+/* internal libraries */
+#include "simulator/Event.hpp"
+#include "simulator/MonteCarloSimulator.hpp"
+
+// generates call arrivals in call received order on demand, only the arrivals of the current hour are kept in memory
+class EventGenerator {
+ private:
+    const MonteCarloSimulator& monteCarloSimulator;
+    std::mt19937 rnd;
+    // hours with arrivals in simulation time order, and the number of arrivals drawn for each hour of the day
+    std::vector<int> hours;
+    std::vector<int> hourlyCounts = std::vector<int>(24, 0);
+    size_t nextHourIndex = 0;
+    // arrivals of the current hour sorted by call received, buffer is reused between hours
+    std::vector<Event> hourEvents;
+    std::vector<int> arrivalOffsets;
+    size_t nextEventIndex = 0;
+    // arrivals are numbered in generation order for their random number streams, generators on one timeline
+    // continue the numbering so every arrival gets its own stream
+    uint64_t nextRandomStreamKey = 0;
+    uint64_t endRandomStreamKey = 0;
+
+    void generateNextHour();
+
+ public:
+    EventGenerator(
+        const MonteCarloSimulator& monteCarloSimulator,
+        const std::mt19937::result_type seed,
+        const uint64_t firstRandomStreamKey = 0
+    );
+    uint64_t getEndRandomStreamKey() const;
+    bool hasNext();
+    const time_t& peekCallReceived();
+    Event next();
+};
@@ -7,20 +7,41 @@
 #pragma once
 
 /* external libraries */
+#include <functional>
 #include <vector>
 /* internal libraries */
 #include "simulator/Event.hpp"
+#include "simulator/EventGenerator.hpp"
+#include "simulator/SimulationCheckpoint.hpp"
 
 class EventHandler {
  private:
     int currentIndex = 0;
+    // only set when arrivals are pulled from a generator instead of given up front
+    EventGenerator* eventGenerator = nullptr;
+    // receives finished events removed from the queue when pulling from a generator
+    std::function<void(const Event&)> retireEvent;
+    int nextEventId = 0;
+
+    void insertEvent(Event event);
+    void pullEvents();
+    void retireEvents();
 
  public:
     std::vector<Event> events;
 
-    EventHandler(std::vector<Event>& events);
+    EventHandler() = default;
     ~EventHandler() = default;
+    void reset(const std::vector<Event>& newEvents, const int newCurrentIndex = 0);
+    void reset(EventGenerator& newEventGenerator, const std::function<void(const Event&)>& newRetireEvent);
+    void resume(const SimulationCheckpoint& checkpoint);
+    void setEventGenerator(EventGenerator& newEventGenerator);
+    bool isStreaming() const {
+        return eventGenerator != nullptr;
+    }
+    int getCurrentIndex() const;
     int getNextEventIndex();
+    void assignNewEventIds(const size_t firstIndex, const size_t numEvents);
     void sortEvent(size_t eventIndex);
     void sortEvents();
 };
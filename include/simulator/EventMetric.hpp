@@ -0,0 +1,24 @@
+/**
+ * @file EventMetric.hpp
+ *
+ * @copyright Copyright (c) 2024 Emergency-Optimizers
+ */
+
+#pragma once
+
+/* external libraries */
+#include <cstddef>
+
+enum class EventMetric {
+    DURATION_INCIDENT_CREATION,
+    DURATION_RESOURCE_APPOINTMENT,
+    DURATION_RESOURCE_PREPARING_DEPARTURE,
+    DURATION_DISPATCHING_TO_SCENE,
+    DURATION_AT_SCENE,
+    DURATION_DISPATCHING_TO_HOSPITAL,
+    DURATION_AT_HOSPITAL,
+    DURATION_DISPATCHING_TO_DEPOT,
+    NONE
+};
+
+const size_t NUM_EVENT_METRICS = static_cast<size_t>(EventMetric::NONE);
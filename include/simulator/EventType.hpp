@@ -14,5 +14,7 @@ enum class EventType {
     DISPATCHING_TO_HOSPITAL,
     PREPARING_DISPATCH_TO_DEPOT,
     DISPATCHING_TO_DEPOT,
-    REALLOCATE
+    REALLOCATE,
+    START_BREAK,
+    END_BREAK
 };
@@ -14,4 +14,6 @@ struct KDEData {
     std::vector<double> weights;
     std::vector<double> points;
     std::vector<double> densities;
+    // inverse CDF table over points, built once so sampling a delay is a binary search without allocation
+    std::vector<double> cumulativeProbabilities;
 };
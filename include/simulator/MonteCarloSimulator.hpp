@@ -7,6 +7,7 @@
 #pragma once
 
 /* external libraries */
+#include <array>
 #include <random>
 #include <vector>
 #include <map>
@@ -14,36 +15,84 @@
 #include <string>
 /* internal libraries */
 #include "file-reader/Settings.hpp"
+#include "simulator/DurationType.hpp"
 #include "simulator/Event.hpp"
 #include "simulator/KDEData.hpp"
+#include "simulator/SimulationConfig.hpp"
+#include "Constants.hpp"
+#include "WeightedSampler.hpp"
+
+// delay between two incident timestamps, sampled from a KDE when generating events
+struct DurationColumns {
+    std::string fromColumn;
+    std::string toColumn;
+    // only use incidents that never went to a hospital
+    bool cancelledOnly;
+};
+
+// the fields of one incident used to build the MCS distributions, read once from the incidents data
+struct IncidentSample {
+    int64_t gridId = -1;
+    int hour = 0;
+    int callYear = 0;
+    int dayOfYear = 0;
+    int triageIndex = -1;
+    int shiftIndex = 0;
+    bool canceled = false;
+    // seconds for each duration type, NaN if a timestamp is missing or the incident is outside the window of every date
+    std::array<double, NUM_DURATION_TYPES> durations;
+};
 
 class MonteCarloSimulator {
  private:
     std::mt19937 rnd = std::mt19937(Settings::get<int>("SEED"));
-    std::vector<int> filteredIncidents;
     const int windowSize = Settings::get<int>("SIMULATION_GENERATION_WINDOW_SIZE");
-    const int year = 2019;
     const int month = Settings::get<int>("SIMULATE_MONTH");
     const int day = Settings::get<int>("SIMULATE_DAY");
     const bool dayShift = Settings::get<bool>("SIMULATE_DAY_SHIFT");
+    const SimulationConfig config = SimulationConfig::fromSettings();
+    // only the first shift of a rolling horizon has a warm-up hour
+    const bool simulate1HourBefore = config.simulate1HourBefore;
+    // shifts of a rolling horizon are placed on one timeline starting at the SimClock date, night shift hours
+    // before midnight then fall on the evening before the simulated date
+    const bool rollingHorizon = false;
+    const int dayOffset = 0;
     std::vector<double> weights;
+    // samplers over the distributions below, built once in the constructor
+    WeightedSampler hourlyIncidentSampler;
+    std::vector<WeightedSampler> triageSamplers;
+    std::vector<std::vector<WeightedSampler>> locationSamplers;
 
-    void generateHourlyIncidentProbabilityDistribution();
-    void generateTriageProbabilityDistribution();
-    void generateCanceledProbabilityDistribution();
-    void generateLocationProbabilityDistribution();
-    int getTotalIncidentsToGenerate();
-    void generateDurationsData(
-        const std::string& fromEventColumn,
-        const std::string& toEventColumn,
-        const bool filterToCancelledEvents = false
+    // indexed by DurationType
+    static inline const auto durationColumns = std::array{
+        DurationColumns{"time_call_received", "time_incident_created", false},
+        DurationColumns{"time_incident_created", "time_resource_appointed", false},
+        DurationColumns{"time_resource_appointed", "time_ambulance_dispatch_to_scene", false},
+        DurationColumns{"time_ambulance_arrived_at_scene", "time_ambulance_dispatch_to_hospital", false},
+        DurationColumns{"time_ambulance_arrived_at_hospital", "time_ambulance_available", false},
+        DurationColumns{"time_ambulance_arrived_at_scene", "time_ambulance_available", true},
+    };
+    static_assert(
+        std::tuple_size<decltype(durationColumns)>::value == NUM_DURATION_TYPES,
+        "durationColumns must have one entry per DurationType"
     );
+
+    // KDE of each duration type, triage and shift in one flat table
+    std::vector<KDEData> kdeTable = std::vector<KDEData>(NUM_DURATION_TYPES * TRIAGES.size() * 2);
+
+    KDEData& getKDEData(const DurationType durationType, const int indexTriage, const int indexShift);
+    const KDEData& getKDEData(const DurationType durationType, const int indexTriage, const int indexShift) const;
+    void generateDistributions(const std::vector<IncidentSample>& incidentSamples);
+    void generateKDEs();
+    void generateSamplers();
     void precomputeKDE(KDEData& kdeData);
-    double sampleFromData(const KDEData& kdeData);
+    double sampleFromData(std::mt19937& eventRnd, const KDEData& kdeData) const;
+    std::vector<Event> generateEvents(std::mt19937& eventRnd, const int totalEvents, const bool showProgress) const;
 
  public:
+    // year of the simulated date, incidents are matched by month and day only
+    static constexpr int year = 2019;
     std::vector<double> hourlyIncidentProbabilityDistribution;
-    std::map<std::pair<std::string, std::string>, std::vector<std::vector<KDEData>>> preProcessedKDEData;
     std::vector<std::vector<double>> triageProbabilityDistribution;
     std::vector<std::vector<double>> canceledProbability;
     std::map<int, int64_t> indexToGridIdMapping;
@@ -51,6 +100,26 @@ class MonteCarloSimulator {
     std::vector<std::vector<std::vector<double>>> locationProbabilityDistribution;
 
     MonteCarloSimulator();
+    MonteCarloSimulator(
+        const std::vector<IncidentSample>& incidentSamples,
+        const int month,
+        const int day,
+        const bool dayShift,
+        const bool simulate1HourBefore,
+        const int dayOffset
+    );
+    // reads the incidents once for all simulated dates given as month and day
+    static std::vector<IncidentSample> readIncidentSamples(const std::vector<std::pair<int, int>>& dates);
     std::vector<double> generateWeights(int weigthSize, double sigma = 1.0);
+    int getTotalIncidentsToGenerate() const;
+    int getCallReceivedDay(const int callReceivedHour) const;
+    int sampleCallReceivedHour(std::mt19937& eventRnd) const;
+    Event generateEvent(
+        std::mt19937& eventRnd,
+        const int callReceivedHour,
+        const int callReceivedMin,
+        const int callReceivedSec
+    ) const;
     std::vector<Event> generateEvents();
+    std::vector<std::vector<Event>> generateScenarios(const int numScenarios);
 };
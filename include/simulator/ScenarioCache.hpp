@@ -0,0 +1,61 @@
+/**
+ * @file ScenarioCache.hpp
+ *
+ * @copyright Copyright (c) 2024 Emergency-Optimizers
+ */
+
+#pragma once
+
+/* external libraries */
+#include <cstdint>
+#include <string>
+#include <vector>
+/* internal libraries */
+#include "simulator/Event.hpp"
+
+// fixed size record of one generated event, written as is to scenario cache files
+struct ScenarioCacheRecord {
+    int64_t timer;
+    int64_t prevTimer;
+    int64_t callReceived;
+    int64_t gridId;
+    int64_t incidentGridId;
+    double secondsWaitCallAnswered;
+    double secondsWaitAppointingResource;
+    double secondsWaitResourcePreparingDeparture;
+    double secondsWaitDepartureScene;
+    double secondsWaitAvailable;
+    int32_t metrics[NUM_EVENT_METRICS];
+    int32_t id;
+    int32_t depotIndexResponsible;
+    int32_t ambulanceIdResponsible;
+    int32_t allocationIndex;
+    uint8_t type;
+    // index into TRIAGES, 255 for an unknown triage impression
+    uint8_t triageIndex;
+    uint8_t urban;
+    uint8_t utility;
+    uint8_t padding[4];
+};
+
+static_assert(sizeof(ScenarioCacheRecord) == 136, "ScenarioCacheRecord must have a fixed size for cache files");
+
+// generated event sets persisted on disk, keyed by the generation settings and a fingerprint of the incidents data
+class ScenarioCache {
+ private:
+    static constexpr uint32_t cacheMagic = 0x43435345;
+    // increment when the record layout or event generation changes
+    static constexpr uint32_t cacheVersion = 1;
+    static constexpr const char* cacheDirName = "scenario_cache";
+    const bool enabled;
+    std::string key;
+    std::string filename;
+
+    static ScenarioCacheRecord toRecord(const Event& event);
+    static Event fromRecord(const ScenarioCacheRecord& record);
+
+ public:
+    ScenarioCache();
+    bool load(std::vector<Event>& events, std::vector<std::vector<Event>>& scenarios) const;
+    void save(const std::vector<Event>& events, const std::vector<std::vector<Event>>& scenarios) const;
+};
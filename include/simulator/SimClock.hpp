@@ -0,0 +1,42 @@
+/**
+ * @file SimClock.hpp
+ *
+ * @copyright Copyright (c) 2024 Emergency-Optimizers
+ */
+
+#pragma once
+
+/* external libraries */
+#include <ctime>
+#include <vector>
+#include <string>
+
+class SimClock {
+ private:
+    // local midnight of the simulated day, all simulation times are seconds relative to this
+    time_t epoch = 0;
+    // calendar date of the epoch, used to resolve hours outside the precomputed window
+    std::tm epochDate{};
+    // hour table covers the day before, the simulated days and the day after
+    const int windowStartHour = -24;
+    std::vector<int> hourOfDay;
+    std::vector<int> dayOfWeek;
+    std::vector<time_t> secondsAtHour;
+
+    SimClock() = default;
+    int getHourSlot(const time_t& time) const;
+
+ public:
+    SimClock(const SimClock&) = delete;
+    SimClock& operator=(const SimClock&) = delete;
+    static SimClock& getInstance() {
+        static SimClock instance;
+        return instance;
+    }
+    void setDate(const int year, const int month, const int day, const int numDays = 1);
+    time_t toSimulationTime(const int hour, const int minute = 0, const int second = 0, const int dayOffset = 0) const;
+    int getHour(const time_t& time) const;
+    int getDayOfWeek(const time_t& time) const;
+    std::tm toLocalTime(const time_t& time) const;
+    std::string toString(const time_t& time) const;
+};
@@ -0,0 +1,31 @@
+/**
+ * @file SimulationCheckpoint.hpp
+ *
+ * @copyright Copyright (c) 2024 Emergency-Optimizers
+ */
+
+#pragma once
+
+/* external libraries */
+#include <memory>
+#include <random>
+#include <vector>
+/* internal libraries */
+#include "simulator/Ambulance.hpp"
+#include "simulator/AvailabilityIndex.hpp"
+#include "simulator/Event.hpp"
+
+// simulator state right before switching to a new time segment of the genotype
+struct SimulationCheckpoint {
+    // checkpoint of the previous time segment, finished events are split over the chain so each is stored once
+    std::shared_ptr<const SimulationCheckpoint> previous;
+    int allocationIndex = 0;
+    // events finished since the previous checkpoint, they are never touched again by the simulation
+    std::vector<Event> finishedEvents;
+    int numFinishedEvents = 0;
+    // events still to be processed when the checkpoint was saved
+    std::vector<Event> pendingEvents;
+    std::vector<Ambulance> ambulances;
+    AvailabilityIndex availabilityIndex;
+    std::mt19937 rnd;
+};
@@ -0,0 +1,39 @@
+/**
+ * @file SimulationConfig.hpp
+ *
+ * @copyright Copyright (c) 2024 Emergency-Optimizers
+ */
+
+#pragma once
+
+/* external libraries */
+#include <cstdint>
+#include <ctime>
+#include <vector>
+/* internal libraries */
+#include "simulator/strategies/DispatchEngineStrategyType.hpp"
+
+// snapshot of the settings and station data used while simulating, read once instead of per lookup
+struct SimulationConfig {
+    int seed = 0;
+    bool simulateDayShift = true;
+    int dayShiftStart = 0;
+    int dayShiftEnd = 0;
+    bool simulate1HourBefore = false;
+    DispatchEngineStrategyType dispatchStrategy = DispatchEngineStrategyType::CLOSEST;
+    bool prioritizeTriage = false;
+    bool responseRestricted = false;
+    bool scheduleBreaks = false;
+    bool commonRandomNumbers = false;
+    int traceBufferSize = 0;
+    bool collectStats = false;
+    std::vector<unsigned> dayShiftDepotIndices;
+    std::vector<unsigned> nightShiftDepotIndices;
+    std::vector<unsigned> hospitalIndices;
+    // grid id of each row in the stations file
+    std::vector<int64_t> stationGridIds;
+
+    static SimulationConfig fromSettings();
+    const std::vector<unsigned>& getDepotIndices(const bool dayShift) const;
+    bool isDayShift(const time_t& time) const;
+};
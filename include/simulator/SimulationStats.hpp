@@ -0,0 +1,42 @@
+/**
+ * @file SimulationStats.hpp
+ *
+ * @copyright Copyright (c) 2024 Emergency-Optimizers
+ */
+
+#pragma once
+
+/* external libraries */
+#include <array>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+/* internal libraries */
+#include "simulator/EventType.hpp"
+
+// counters and handler latency histograms of the simulation loop, aggregated over every run of a simulator
+class SimulationStats {
+ private:
+    static const size_t NUM_EVENT_TYPES = static_cast<size_t>(EventType::END_BREAK) + 1;
+    // bucket i counts handler calls taking [2^i, 2^(i + 1)) nanoseconds
+    static const size_t NUM_LATENCY_BUCKETS = 40;
+
+    std::array<int64_t, NUM_EVENT_TYPES> handlerCalls = {};
+    std::array<int64_t, NUM_EVENT_TYPES> handlerNanoseconds = {};
+    std::array<std::array<int64_t, NUM_LATENCY_BUCKETS>, NUM_EVENT_TYPES> handlerLatencyHistograms = {};
+    int64_t fullSorts = 0;
+    int64_t waitRetries = 0;
+    int64_t travelTimeCalls = 0;
+
+ public:
+    void recordHandler(
+        const EventType type,
+        const int64_t nanoseconds,
+        const bool fullSort,
+        const bool waitRetry,
+        const int64_t newTravelTimeCalls
+    );
+    void merge(const SimulationStats& other);
+    std::map<std::string, std::vector<std::vector<double>>> toDataMap() const;
+};
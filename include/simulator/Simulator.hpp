@@ -7,26 +7,72 @@
 #pragma once
 
 /* external libraries */
+#include <functional>
 #include <random>
 #include <vector>
+#include <memory>
 /* internal libraries */
-#include "file-reader/Settings.hpp"
+#include "CounterRandom.hpp"
 #include "simulator/AmbulanceAllocator.hpp"
+#include "simulator/EventGenerator.hpp"
 #include "simulator/EventHandler.hpp"
-#include "simulator/strategies/DispatchEngineStrategyType.hpp"
+#include "simulator/SimulationConfig.hpp"
+#include "simulator/SimulationCheckpoint.hpp"
+#include "simulator/TraceRecorder.hpp"
+#include "simulator/strategies/DispatchBuffers.hpp"
+#include "simulator/SimulationStats.hpp"
 
+// long lived simulator, reset between runs so its buffers are reused
 class Simulator {
  private:
-    std::mt19937 rnd = std::mt19937(Settings::get<int>("SEED"));
-    AmbulanceAllocator& ambulanceAllocator;
+    const SimulationConfig& config;
+    std::mt19937 rnd;
     EventHandler eventHandler;
-    DispatchEngineStrategyType dispatchStrategy;
+    // reseeded for every processed event in common random numbers mode
+    CounterRandom eventRnd;
+    // scratch space of the dispatch handlers, kept between events and runs
+    DispatchBuffers dispatchBuffers;
+    // event loop specialized for the dispatch strategy and policies in config, picked once in the constructor
+    const std::vector<Event>& (Simulator::*runEvents)(
+        std::shared_ptr<const SimulationCheckpoint>* checkpoint,
+        const time_t& endTime
+    );
+
+    std::shared_ptr<const SimulationCheckpoint> saveCheckpoint(
+        const std::shared_ptr<const SimulationCheckpoint>& previous,
+        const int allocationIndex
+    ) const;
+    template <
+        typename Strategy,
+        bool commonRandomNumbers,
+        bool prioritizeTriage,
+        bool responseRestricted,
+        bool scheduleBreaks
+    >
+    const std::vector<Event>& runStrategy(
+        std::shared_ptr<const SimulationCheckpoint>* checkpoint,
+        const time_t& endTime
+    );
+    template <typename Strategy, bool... flags>
+    void selectStrategy();
 
  public:
-    Simulator(
-        AmbulanceAllocator& ambulanceAllocator,
-        DispatchEngineStrategyType dispatchStrategy,
-        std::vector<Event> events
+    AmbulanceAllocator ambulanceAllocator;
+    // last processed event steps of the current run, only recorded if enabled in config
+    TraceRecorder traceRecorder;
+    // loop counters and handler latencies summed over all runs, only collected if enabled in config
+    SimulationStats stats;
+
+    Simulator(const SimulationConfig& config);
+    void reset(const std::vector<Event>& events, const std::vector<std::vector<int>>& allocations);
+    void reset(
+        EventGenerator& eventGenerator,
+        const std::vector<std::vector<int>>& allocations,
+        const std::function<void(const Event&)>& retireEvent
     );
-    std::vector<Event> run();
+    void startShift(EventGenerator& eventGenerator, const std::vector<std::vector<int>>& allocations, const time_t& shiftStart);
+    void resume(const SimulationCheckpoint& checkpoint, const std::vector<std::vector<int>>& allocations);
+    const std::vector<Event>& run(std::shared_ptr<const SimulationCheckpoint>* checkpoint = nullptr);
+    void runUntil(const time_t& endTime);
+    void swapResults(std::vector<Event>& events, std::vector<Ambulance>& ambulances);
 };
@@ -0,0 +1,54 @@
+/**
+ * @file TraceRecorder.hpp
+ *
+ * @copyright Copyright (c) 2024 Emergency-Optimizers
+ */
+
+#pragma once
+
+/* external libraries */
+#include <cstdint>
+#include <ctime>
+#include <string>
+#include <vector>
+/* internal libraries */
+#include "simulator/EventType.hpp"
+
+// fixed size record of one processed event step, written as is to trace files
+struct TraceRecord {
+    int64_t timer;
+    int32_t eventId;
+    int32_t ambulanceId;
+    // drawn travel time for steps that travel, otherwise the seconds the event timer advanced in this step
+    int32_t duration;
+    uint8_t fromType;
+    uint8_t toType;
+    uint16_t padding;
+};
+
+static_assert(sizeof(TraceRecord) == 24, "TraceRecord must have a fixed size for trace files");
+
+// ring buffer keeping the last processed event steps of a simulation run
+class TraceRecorder {
+ private:
+    std::vector<TraceRecord> records;
+    size_t nextIndex = 0;
+    bool wrapped = false;
+
+ public:
+    void setCapacity(const int capacity);
+    void clear();
+    bool isEnabled() const {
+        return !records.empty();
+    }
+    void record(
+        const time_t& timer,
+        const int eventId,
+        const int ambulanceId,
+        const int duration,
+        const EventType fromType,
+        const EventType toType
+    );
+    void write(const std::string& dirName, const std::string& fileName = "trace") const;
+    static void decode(const std::string& traceFilename, const std::string& csvFilename);
+};
@@ -9,37 +9,461 @@
 /* external libraries */
 #include <vector>
 #include <random>
+#include <limits>
+#include <algorithm>
+#include <numeric>
 /* internal libraries */
 #include "simulator/strategies/DispatchEngineStrategy.hpp"
 #include "simulator/Ambulance.hpp"
+#include "simulator/AvailabilityIndex.hpp"
+#include "simulator/strategies/DispatchBuffers.hpp"
 #include "simulator/Event.hpp"
+#include "simulator/SimulationConfig.hpp"
+#include "Utils.hpp"
+#include "file-reader/ODMatrix.hpp"
 
 class ClosestDispatchEngineStrategy : public DispatchEngineStrategy {
  protected:
+    template <typename Policy, typename Random>
     static bool assigningAmbulance(
-        std::mt19937& rnd,
+        Random& rnd,
         std::vector<Ambulance>& ambulances,
+        const AvailabilityIndex& availabilityIndex,
+        DispatchBuffers& buffers,
         std::vector<Event>& events,
         const int eventIndex
     );
+    template <typename Random>
     static void dispatchingToHospital(
-        std::mt19937& rnd,
-        std::vector<Ambulance>& ambulances,
+        Random& rnd,
+        const SimulationConfig& config,
         std::vector<Event>& events,
         const int eventIndex
     );
+    template <typename Random>
     static void reallocating(
-        std::mt19937& rnd,
+        Random& rnd,
+        const SimulationConfig& config,
         std::vector<Ambulance>& ambulances,
+        const std::vector<std::vector<int>>& allocations,
+        DispatchBuffers& buffers,
         std::vector<Event>& events,
         const int eventIndex
     );
 
  public:
+    template <typename Policy, typename Random>
     static bool run(
-        std::mt19937& rnd,
+        Random& rnd,
+        const SimulationConfig& config,
         std::vector<Ambulance>& ambulances,
+        const AvailabilityIndex& availabilityIndex,
+        const std::vector<std::vector<int>>& allocations,
+        DispatchBuffers& buffers,
         std::vector<Event>& events,
         const int eventIndex
     );
 };
+
+template <typename Policy, typename Random>
+bool ClosestDispatchEngineStrategy::run(
+    Random& rnd,
+    const SimulationConfig& config,
+    std::vector<Ambulance>& ambulances,
+    const AvailabilityIndex& availabilityIndex,
+    const std::vector<std::vector<int>>& allocations,
+    DispatchBuffers& buffers,
+    std::vector<Event>& events,
+    const int eventIndex
+) {
+    bool sortAllEvents = false;
+
+    // process event based on type, according to CDS (Closest Dispatch Strategy)
+    switch (events[eventIndex].type) {
+        case EventType::RESOURCE_APPOINTMENT:
+            sortAllEvents = assigningAmbulance<Policy>(rnd, ambulances, availabilityIndex, buffers, events, eventIndex);
+            break;
+        case EventType::PREPARING_DISPATCH_TO_SCENE:
+            preparingToDispatchToScene(rnd, events, eventIndex);
+            break;
+        case EventType::DISPATCHING_TO_SCENE:
+            dispatchingToScene(rnd, events, eventIndex);
+            break;
+        case EventType::DISPATCHING_TO_HOSPITAL:
+            dispatchingToHospital(rnd, config, events, eventIndex);
+            break;
+        case EventType::PREPARING_DISPATCH_TO_DEPOT:
+            dispatchingToDepot(rnd, config, events, eventIndex);
+            break;
+        case EventType::DISPATCHING_TO_DEPOT:
+            finishingEvent(rnd, config, events, eventIndex);
+            break;
+        case EventType::REALLOCATE:
+            // handles reallocation events
+            reallocating(rnd, config, ambulances, allocations, buffers, events, eventIndex);
+            break;
+        case EventType::START_BREAK:
+            // break events only exist if breaks are scheduled
+            if (Policy::scheduleBreaks) {
+                startingBreak(ambulances, events, eventIndex);
+            }
+            break;
+        case EventType::END_BREAK:
+            if (Policy::scheduleBreaks) {
+                endingBreak(config, events, eventIndex);
+            }
+            break;
+        case EventType::NONE:
+            break;
+    }
+
+    return sortAllEvents;
+}
+
+template <typename Policy, typename Random>
+bool ClosestDispatchEngineStrategy::assigningAmbulance(
+    Random& rnd,
+    std::vector<Ambulance>& ambulances,
+    const AvailabilityIndex& availabilityIndex,
+    DispatchBuffers& buffers,
+    std::vector<Event>& events,
+    const int eventIndex
+) {
+    bool sortAllEvents = false;
+
+    // get pool of available ambulances
+    std::vector<unsigned>& availableAmbulanceIndicies = buffers.availableAmbulanceIndicies;
+    getAvailableAmbulanceIndicies<Policy>(
+        availableAmbulanceIndicies,
+        ambulances,
+        availabilityIndex,
+        events[eventIndex].triageImpression
+    );
+
+    // if no ambulances are available, wait until after next event in queue is processed
+    if (availableAmbulanceIndicies.empty()) {
+        int waitTime = 60;
+
+        const bool noEventsLeft = static_cast<size_t>(eventIndex) + 1 >= events.size();
+        if (!noEventsLeft) {
+            int durationUntilNextEvent = static_cast<int>(events[eventIndex + 1].timer - events[eventIndex].timer);
+
+            waitTime = durationUntilNextEvent + 1;
+        }
+
+        events[eventIndex].updateTimer(waitTime, EventMetric::DURATION_RESOURCE_APPOINTMENT);
+
+        return sortAllEvents;
+    }
+
+    // find closest ambulance by iterating through each ambulance in pool
+    int closestAmbulanceIndex = -1;
+    int64_t closestAmbulanceGridId = -1;
+    int closestAmbulanceTravelTime = std::numeric_limits<int>::max();
+    int closestAmbulanceWorkedTime = std::numeric_limits<int>::max();
+    int64_t eventGridId = events[eventIndex].gridId;
+    // std::pair<int, int> utm1 = idToUtm(eventGridId);
+    for (size_t i = 0; i < availableAmbulanceIndicies.size(); i++) {
+        int64_t ambulanceGridId;
+
+        if (ambulances[availableAmbulanceIndicies[i]].assignedEventId != -1) {
+            // if ambulance is already assigned to an event, approximate its location
+            // can only happen when travelling to scene (policy), or travelling to depot
+            int currentAmbulanceEventIndex = findEventIndexFromId(events, ambulances[availableAmbulanceIndicies[i]].assignedEventId);
+
+            ambulanceGridId = approximateLocation(
+                rnd,
+                ambulances[availableAmbulanceIndicies[i]].currentGridId,
+                events[currentAmbulanceEventIndex].gridId,
+                events[currentAmbulanceEventIndex].prevTimer,
+                events[eventIndex].timer,
+                events[currentAmbulanceEventIndex].triageImpression,
+                events[currentAmbulanceEventIndex].type
+            );
+
+            // if apporximated location is not available in sparse OD cost matrix, skip this ambulance
+            if (!ODMatrix::getInstance().gridIdExists(ambulanceGridId)) {
+                continue;
+            }
+        } else {
+            ambulanceGridId = ambulances[availableAmbulanceIndicies[i]].currentGridId;
+        }
+
+        int travelTime = ODMatrix::getInstance().getTravelTime(
+            rnd,
+            ambulanceGridId,
+            eventGridId,
+            false,
+            events[eventIndex].triageImpression,
+            events[eventIndex].timer
+        );
+
+        // same distance calculation used by OUH, only used for testing
+        /*std::pair<int, int> utm2 = idToUtm(ambulanceGridId);
+        travelTime = calculateEuclideanDistance(
+            static_cast<double>(utm1.first),
+            static_cast<double>(utm1.second),
+            static_cast<double>(utm2.first),
+            static_cast<double>(utm2.second)
+        );*/
+
+        // check if this ambulance is closer than the current best
+        // sort by UHU if equally close
+        const int ambulanceWorkedTime = ambulances[availableAmbulanceIndicies[i]].timeUnavailable;
+
+        const bool closer = travelTime < closestAmbulanceTravelTime;
+        const bool equallyClose = travelTime == closestAmbulanceTravelTime;
+        const bool workedLess = ambulanceWorkedTime < closestAmbulanceWorkedTime;
+
+        if (closer || (equallyClose && workedLess)) {
+            closestAmbulanceIndex = availableAmbulanceIndicies[i];
+            closestAmbulanceGridId = ambulanceGridId;
+            closestAmbulanceTravelTime = travelTime;
+            closestAmbulanceWorkedTime = ambulanceWorkedTime;
+        }
+    }
+
+    // check again if no ambulances are available, wait until after next event in queue is processed
+    // can trigger if the ambulances in the pool approximated location is not in OD cost matrix
+    if (closestAmbulanceIndex == -1) {
+        int waitTime = 60;
+
+        const bool noEventsLeft = static_cast<size_t>(eventIndex) + 1 >= events.size();
+        if (!noEventsLeft) {
+            int durationUntilNextEvent = static_cast<int>(events[eventIndex + 1].timer - events[eventIndex].timer);
+
+            waitTime = durationUntilNextEvent + 1;
+        }
+
+        events[eventIndex].updateTimer(waitTime, EventMetric::DURATION_RESOURCE_APPOINTMENT);
+
+        return sortAllEvents;
+    }
+
+    // special handling if ambulance was already assigned to an event
+    if (ambulances[closestAmbulanceIndex].assignedEventId != -1) {
+        int currentAmbulanceEventIndex = findEventIndexFromId(events, ambulances[closestAmbulanceIndex].assignedEventId);
+        int incrementSeconds;
+
+        if (events[currentAmbulanceEventIndex].type == EventType::DISPATCHING_TO_DEPOT) {
+            // use prevTimer here to only get the traffic influence at previous step
+            incrementSeconds = ODMatrix::getInstance().getTravelTime(
+                rnd,
+                ambulances[closestAmbulanceIndex].currentGridId,
+                closestAmbulanceGridId,
+                true,
+                events[currentAmbulanceEventIndex].triageImpression,
+                events[currentAmbulanceEventIndex].prevTimer
+            );
+            const bool dontUpdateTimer = true;
+            events[currentAmbulanceEventIndex].updateTimer(incrementSeconds, EventMetric::DURATION_DISPATCHING_TO_DEPOT, dontUpdateTimer);
+
+            events[currentAmbulanceEventIndex].gridId = closestAmbulanceGridId;
+            events[currentAmbulanceEventIndex].setType(EventType::NONE);
+        } else if (events[currentAmbulanceEventIndex].type == EventType::DISPATCHING_TO_SCENE) {
+            incrementSeconds = ODMatrix::getInstance().getTravelTime(
+                rnd,
+                ambulances[closestAmbulanceIndex].currentGridId,
+                closestAmbulanceGridId,
+                false,
+                events[currentAmbulanceEventIndex].triageImpression,
+                events[currentAmbulanceEventIndex].prevTimer
+            );
+
+            // set old event metrics to resource appointment (wait time in queue)
+            int oldMetrics = events[currentAmbulanceEventIndex].getMetric(EventMetric::DURATION_RESOURCE_PREPARING_DEPARTURE);
+            events[currentAmbulanceEventIndex].getMetric(EventMetric::DURATION_RESOURCE_PREPARING_DEPARTURE) = 0;
+
+            events[currentAmbulanceEventIndex].getMetric(EventMetric::DURATION_RESOURCE_APPOINTMENT) += incrementSeconds + oldMetrics;
+            ambulances[closestAmbulanceIndex].timeUnavailable += incrementSeconds;
+
+            events[currentAmbulanceEventIndex].setType(EventType::RESOURCE_APPOINTMENT);
+
+            // reset timer
+            int oldEventTravelTime = ODMatrix::getInstance().getTravelTime(
+                rnd,
+                ambulances[closestAmbulanceIndex].currentGridId,
+                events[currentAmbulanceEventIndex].gridId,
+                false,
+                events[currentAmbulanceEventIndex].triageImpression,
+                events[currentAmbulanceEventIndex].prevTimer
+            );
+
+            events[currentAmbulanceEventIndex].timer -= oldEventTravelTime;
+            events[currentAmbulanceEventIndex].timer += incrementSeconds;
+
+            sortAllEvents = true;
+        }
+
+        events[currentAmbulanceEventIndex].removeAssignedAmbulance();
+
+        ambulances[closestAmbulanceIndex].currentGridId = closestAmbulanceGridId;
+    }
+
+    // assign ambulance to event
+    events[eventIndex].assignAmbulance(ambulances[closestAmbulanceIndex]);
+    events[eventIndex].setType(EventType::PREPARING_DISPATCH_TO_SCENE);
+    events[eventIndex].updateTimer(
+        static_cast<int>(events[eventIndex].secondsWaitResourcePreparingDeparture),
+        EventMetric::DURATION_RESOURCE_PREPARING_DEPARTURE
+    );
+
+    return sortAllEvents;
+}
+
+template <typename Random>
+void ClosestDispatchEngineStrategy::dispatchingToHospital(
+    Random& rnd,
+    const SimulationConfig& config,
+    std::vector<Event>& events,
+    const int eventIndex
+) {
+    // find closest hospital
+    int closestHospitalIndex = -1;
+    int closestHospitalTravelTime = std::numeric_limits<int>::max();
+    int64_t eventGridId = events[eventIndex].gridId;
+    const std::vector<unsigned int>& hospitals = config.hospitalIndices;
+    for (size_t i = 0; i < hospitals.size(); i++) {
+        int64_t hospitalGridId = config.stationGridIds[hospitals[i]];
+        int travelTime = ODMatrix::getInstance().getTravelTime(
+            rnd,
+            eventGridId,
+            hospitalGridId,
+            false,
+            events[eventIndex].triageImpression,
+            events[eventIndex].timer
+        );
+        if (travelTime < closestHospitalTravelTime) {
+            closestHospitalIndex = static_cast<int>(i);
+            closestHospitalTravelTime = travelTime;
+        }
+    }
+
+    events[eventIndex].gridId = config.stationGridIds[hospitals[closestHospitalIndex]];
+
+    events[eventIndex].updateTimer(closestHospitalTravelTime, EventMetric::DURATION_DISPATCHING_TO_HOSPITAL);
+
+    events[eventIndex].assignedAmbulance->currentGridId = events[eventIndex].gridId;
+
+    events[eventIndex].updateTimer(static_cast<int>(events[eventIndex].secondsWaitAvailable), EventMetric::DURATION_AT_HOSPITAL);
+
+    events[eventIndex].setType(EventType::PREPARING_DISPATCH_TO_DEPOT);
+}
+
+template <typename Random>
+void ClosestDispatchEngineStrategy::reallocating(
+    Random& rnd,
+    const SimulationConfig& config,
+    std::vector<Ambulance>& ambulances,
+    const std::vector<std::vector<int>>& allocations,
+    DispatchBuffers& buffers,
+    std::vector<Event>& events,
+    const int eventIndex
+) {
+    // get depot indices
+    const std::vector<unsigned int>& depotIndices = config.getDepotIndices(config.isDayShift(events[eventIndex].timer));
+
+    // get the new allocation from reallocation event, ambulances left to place per depot are counted down in a copy
+    const std::vector<int>& allocation = allocations[events[eventIndex].allocationIndex];
+    std::vector<int>& remainingAllocation = buffers.remainingAllocation;
+    remainingAllocation.assign(allocation.begin(), allocation.end());
+
+    // create a vector of ambulance indices
+    std::vector<int>& ambulanceIndices = buffers.ambulanceIndices;
+    ambulanceIndices.resize(ambulances.size());
+    std::iota(ambulanceIndices.begin(), ambulanceIndices.end(), 0);
+
+    // remove ambulances from possible reallocation if already at correct depot
+    for (size_t depotIndex = 0; depotIndex < depotIndices.size(); depotIndex++) {
+        for (size_t ambulanceIndex = 0; ambulanceIndex < ambulances.size(); ambulanceIndex++) {
+            if (remainingAllocation[depotIndex] <= 0) {
+                break;
+            }
+
+            if (ambulances[ambulanceIndex].allocatedDepotIndex == static_cast<int>(depotIndex)) {
+                ambulanceIndices.erase(
+                    std::remove(ambulanceIndices.begin(), ambulanceIndices.end(), static_cast<int>(ambulanceIndex)),
+                    ambulanceIndices.end()
+                );
+
+                remainingAllocation[depotIndex]--;
+            }
+        }
+    }
+
+    // sort the indicies to adhere to the closest strategy
+    std::vector<int>& sortedAmbulanceIndices = buffers.sortedAmbulanceIndices;
+    sortedAmbulanceIndices.clear();
+    for (size_t depotIndex = 0; depotIndex < depotIndices.size(); depotIndex++) {
+        unsigned int allocatedToDepot = remainingAllocation[depotIndex];
+        for (unsigned int i = 0; i < allocatedToDepot; i++) {
+            size_t closestAmbulanceIndex = 0;
+            int closestTravelTime = std::numeric_limits<int>::max();
+            for (size_t ambulanceIndex = 0; ambulanceIndex < ambulanceIndices.size(); ambulanceIndex++) {
+                int64_t depotGridId = config.stationGridIds[depotIndices[depotIndex]];
+
+                int travelTime = ODMatrix::getInstance().getTravelTime(
+                    rnd,
+                    ambulances[ambulanceIndices[ambulanceIndex]].currentGridId,
+                    depotGridId,
+                    true,
+                    "V1",
+                    events[eventIndex].timer
+                );
+
+                if (travelTime < closestTravelTime) {
+                    closestAmbulanceIndex = ambulanceIndex;
+                    closestTravelTime = travelTime;
+                }
+            }
+
+            sortedAmbulanceIndices.push_back(ambulanceIndices[closestAmbulanceIndex]);
+            ambulanceIndices.erase(ambulanceIndices.begin() + closestAmbulanceIndex);
+        }
+    }
+
+    // reallocate by assigning the ambulance indices to the depot according to allocation vector
+    size_t currentAmbulanceIndex = 0;
+    for (size_t depotIndex = 0; depotIndex < depotIndices.size() && currentAmbulanceIndex < sortedAmbulanceIndices.size(); depotIndex++) {
+        unsigned int allocatedToDepot = remainingAllocation[depotIndex];
+        for (unsigned int i = 0; i < allocatedToDepot && currentAmbulanceIndex < sortedAmbulanceIndices.size(); i++) {
+            /*std::cout << "Ambulance " << ambulances[sortedAmbulanceIndices[currentAmbulanceIndex]].id << ": "
+                << ambulances[sortedAmbulanceIndices[currentAmbulanceIndex]].allocatedDepotIndex
+                << " -> " << depotIndices[depotIndex] << std::endl;*/
+
+            // allocate ambulance to new depot
+            ambulances[sortedAmbulanceIndices[currentAmbulanceIndex]].reallocate(depotIndices[depotIndex]);
+
+            // branch if it isn't responding to an incident and create an event that transfers the ambulance to the new depot
+            if (ambulances[sortedAmbulanceIndices[currentAmbulanceIndex]].assignedEventId == -1) {
+                Event newEvent;
+                newEvent.id = static_cast<int>(events.size());
+                newEvent.type = EventType::PREPARING_DISPATCH_TO_DEPOT;
+                newEvent.timer = events[eventIndex].timer;
+                newEvent.prevTimer = events[eventIndex].timer;
+                newEvent.callReceived = events[eventIndex].timer;
+                newEvent.assignAmbulance(ambulances[sortedAmbulanceIndices[currentAmbulanceIndex]]);
+                // set to V1 to force traffic factor on travel time
+                newEvent.triageImpression = "V1";
+                newEvent.gridId = ambulances[sortedAmbulanceIndices[currentAmbulanceIndex]].currentGridId;
+                newEvent.utility = true;
+                newEvent.randomStreamKey = deriveStreamKey(
+                    events[eventIndex].randomStreamKey,
+                    static_cast<uint64_t>(ambulances[sortedAmbulanceIndices[currentAmbulanceIndex]].id)
+                );
+
+                events.insert(events.begin() + eventIndex + 1, newEvent);
+            }
+
+            currentAmbulanceIndex++;
+        }
+    }
+
+    // increment allocation index for each ambulance
+    for (size_t ambulanceIndex = 0; ambulanceIndex < ambulances.size(); ambulanceIndex++) {
+        ambulances[ambulanceIndex].currentAllocationIndex++;
+    }
+
+    // set the type to none so it doesn't trigger again
+    events[eventIndex].setType(EventType::NONE);
+}
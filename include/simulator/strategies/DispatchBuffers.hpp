@@ -0,0 +1,20 @@
+/**
+ * @file DispatchBuffers.hpp
+ *
+ * @copyright Copyright (c) 2024 Emergency-Optimizers
+ */
+
+#pragma once
+
+/* external libraries */
+#include <vector>
+
+// scratch space for the dispatch strategies, owned by the simulator so handlers don't allocate per event
+struct DispatchBuffers {
+    // pool of ambulances that can be assigned to the current event
+    std::vector<unsigned> availableAmbulanceIndicies;
+    // ambulances still to be placed and remaining ambulances per depot during a reallocation
+    std::vector<int> ambulanceIndices;
+    std::vector<int> sortedAmbulanceIndices;
+    std::vector<int> remainingAllocation;
+};
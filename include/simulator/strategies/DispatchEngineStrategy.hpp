@@ -11,58 +11,258 @@
 #include <random>
 /* internal libraries */
 #include "simulator/Ambulance.hpp"
+#include "simulator/AvailabilityIndex.hpp"
+#include "simulator/strategies/DispatchBuffers.hpp"
 #include "simulator/Event.hpp"
+#include "simulator/SimulationConfig.hpp"
+#include "Utils.hpp"
+#include "file-reader/ODMatrix.hpp"
 
 class DispatchEngineStrategy {
  protected:
-    static bool assigningAmbulance(
-        std::mt19937& rnd,
-        std::vector<Ambulance>& ambulances,
-        std::vector<Event>& events,
-        const int eventIndex
-    );
+    // handlers shared by all strategies, assigning ambulances, dispatching to hospital and reallocating are done by each strategy
+    template <typename Random>
     static void preparingToDispatchToScene(
-        std::mt19937& rnd,
-        std::vector<Ambulance>& ambulances,
+        Random& rnd,
         std::vector<Event>& events,
         const int eventIndex
     );
+    template <typename Random>
     static void dispatchingToScene(
-        std::mt19937& rnd,
-        std::vector<Ambulance>& ambulances,
+        Random& rnd,
         std::vector<Event>& events,
         const int eventIndex
     );
-    static void dispatchingToHospital(
-        std::mt19937& rnd,
-        std::vector<Ambulance>& ambulances,
+    template <typename Random>
+    static void dispatchingToDepot(
+        Random& rnd,
+        const SimulationConfig& config,
         std::vector<Event>& events,
         const int eventIndex
     );
-    static void dispatchingToDepot(
-        std::mt19937& rnd,
-        std::vector<Ambulance>& ambulances,
+    template <typename Random>
+    static void finishingEvent(
+        Random& rnd,
+        const SimulationConfig& config,
         std::vector<Event>& events,
         const int eventIndex
     );
-    static void finishingEvent(
-        std::mt19937& rnd,
+    static void startingBreak(
         std::vector<Ambulance>& ambulances,
         std::vector<Event>& events,
         const int eventIndex
     );
-    static void reallocating(
-        std::mt19937& rnd,
-        std::vector<Ambulance>& ambulances,
+    static void endingBreak(
+        const SimulationConfig& config,
         std::vector<Event>& events,
         const int eventIndex
     );
 
  public:
+    template <typename Policy, typename Random>
     static bool run(
-        std::mt19937& rnd,
+        Random& rnd,
+        const SimulationConfig& config,
         std::vector<Ambulance>& ambulances,
+        const AvailabilityIndex& availabilityIndex,
+        const std::vector<std::vector<int>>& allocations,
+        DispatchBuffers& buffers,
         std::vector<Event>& events,
         const int eventIndex
     );
 };
+
+template <typename Random>
+void DispatchEngineStrategy::preparingToDispatchToScene(
+    Random& rnd,
+    std::vector<Event>& events,
+    const int eventIndex
+) {
+    const bool forceTrafficFactor = false;
+    int incrementSeconds = ODMatrix::getInstance().getTravelTime(
+        rnd,
+        events[eventIndex].assignedAmbulance->currentGridId,
+        events[eventIndex].gridId,
+        forceTrafficFactor,
+        events[eventIndex].triageImpression,
+        events[eventIndex].timer
+    );
+
+    events[eventIndex].updateTimer(incrementSeconds);
+
+    events[eventIndex].setType(EventType::DISPATCHING_TO_SCENE);
+}
+
+template <typename Random>
+void DispatchEngineStrategy::dispatchingToScene(
+    Random& rnd,
+    std::vector<Event>& events,
+    const int eventIndex
+) {
+    const bool forceTrafficFactor = false;
+    int incrementSeconds = ODMatrix::getInstance().getTravelTime(
+        rnd,
+        events[eventIndex].assignedAmbulance->currentGridId,
+        events[eventIndex].gridId,
+        forceTrafficFactor,
+        events[eventIndex].triageImpression,
+        events[eventIndex].prevTimer
+    );
+
+    const bool dontUpdateTimer = true;
+    events[eventIndex].updateTimer(incrementSeconds, EventMetric::DURATION_DISPATCHING_TO_SCENE, dontUpdateTimer);
+
+    events[eventIndex].assignedAmbulance->currentGridId = events[eventIndex].gridId;
+
+    // set event type to travel directly to depot if event is set to cancelled
+    // cancelled here is defined as a mission which doesn't bring the patient to the hospital
+    const bool cancelledEvent = events[eventIndex].secondsWaitDepartureScene == -1;
+    if (!cancelledEvent) {
+        incrementSeconds = static_cast<int>(events[eventIndex].secondsWaitDepartureScene);
+        events[eventIndex].updateTimer(incrementSeconds, EventMetric::DURATION_AT_SCENE);
+
+        events[eventIndex].setType(EventType::DISPATCHING_TO_HOSPITAL);
+    } else {
+        incrementSeconds = static_cast<int>(events[eventIndex].secondsWaitAvailable);
+        events[eventIndex].updateTimer(incrementSeconds, EventMetric::DURATION_AT_SCENE);
+
+        events[eventIndex].setType(EventType::PREPARING_DISPATCH_TO_DEPOT);
+    }
+}
+
+template <typename Random>
+void DispatchEngineStrategy::dispatchingToDepot(
+    Random& rnd,
+    const SimulationConfig& config,
+    std::vector<Event>& events,
+    const int eventIndex
+) {
+    events[eventIndex].gridId = config.stationGridIds[events[eventIndex].assignedAmbulance->allocatedDepotIndex];
+
+    const bool forceTrafficFactor = true;
+    int incrementSeconds = ODMatrix::getInstance().getTravelTime(
+        rnd,
+        events[eventIndex].assignedAmbulance->currentGridId,
+        events[eventIndex].gridId,
+        forceTrafficFactor,
+        events[eventIndex].triageImpression,
+        events[eventIndex].timer
+    );
+    events[eventIndex].updateTimer(incrementSeconds);
+
+    events[eventIndex].setType(EventType::DISPATCHING_TO_DEPOT);
+}
+
+template <typename Random>
+void DispatchEngineStrategy::finishingEvent(
+    Random& rnd,
+    const SimulationConfig& config,
+    std::vector<Event>& events,
+    const int eventIndex
+) {
+    const bool forceTrafficFactor = true;
+    int incrementSeconds = ODMatrix::getInstance().getTravelTime(
+        rnd,
+        events[eventIndex].assignedAmbulance->currentGridId,
+        events[eventIndex].gridId,
+        forceTrafficFactor,
+        events[eventIndex].triageImpression,
+        events[eventIndex].prevTimer
+    );
+    const bool dontUpdateTimer = true;
+    events[eventIndex].updateTimer(incrementSeconds, EventMetric::DURATION_DISPATCHING_TO_DEPOT, dontUpdateTimer);
+    events[eventIndex].assignedAmbulance->currentGridId = events[eventIndex].gridId;
+
+    // check if ambulance has been reallocated and send it to new depot
+    int64_t assignedDepotGridId = config.stationGridIds[events[eventIndex].assignedAmbulance->allocatedDepotIndex];
+    if (events[eventIndex].assignedAmbulance->currentGridId != assignedDepotGridId) {
+        events[eventIndex].setType(EventType::PREPARING_DISPATCH_TO_DEPOT);
+
+        return;
+    }
+
+    Ambulance* ambulance = events[eventIndex].assignedAmbulance;
+    events[eventIndex].removeAssignedAmbulance();
+
+    events[eventIndex].setType(EventType::NONE);
+
+    // take break that was postponed while the ambulance was busy, now that it is back at depot
+    if (ambulance->pendingBreaks > 0) {
+        ambulance->pendingBreaks--;
+
+        Event newEvent;
+        newEvent.id = static_cast<int>(events.size());
+        newEvent.type = EventType::START_BREAK;
+        newEvent.timer = events[eventIndex].timer;
+        newEvent.prevTimer = events[eventIndex].timer;
+        newEvent.callReceived = events[eventIndex].timer;
+        newEvent.ambulanceIdResponsible = ambulance->id;
+        newEvent.utility = true;
+        newEvent.randomStreamKey = deriveStreamKey(
+            events[eventIndex].randomStreamKey,
+            static_cast<uint64_t>(EventType::START_BREAK)
+        );
+
+        events.insert(events.begin() + eventIndex + 1, newEvent);
+    }
+}
+
+inline void DispatchEngineStrategy::startingBreak(
+    std::vector<Ambulance>& ambulances,
+    std::vector<Event>& events,
+    const int eventIndex
+) {
+    const int MIN_30 = 30 * 60;
+
+    Ambulance& ambulance = ambulances[events[eventIndex].ambulanceIdResponsible];
+
+    // postpone break until ambulance is back at depot if it is busy
+    if (ambulance.assignedEventId != -1) {
+        ambulance.pendingBreaks++;
+
+        events[eventIndex].setType(EventType::NONE);
+
+        return;
+    }
+
+    events[eventIndex].assignAmbulance(ambulance);
+    events[eventIndex].updateTimer(MIN_30);
+
+    events[eventIndex].setType(EventType::END_BREAK);
+}
+
+inline void DispatchEngineStrategy::endingBreak(
+    const SimulationConfig& config,
+    std::vector<Event>& events,
+    const int eventIndex
+) {
+    const int MIN_30 = 30 * 60;
+
+    Ambulance* ambulance = events[eventIndex].assignedAmbulance;
+    ambulance->timeNotWorking += MIN_30;
+
+    // start next break right away if another one became due during this one
+    if (ambulance->pendingBreaks > 0) {
+        ambulance->pendingBreaks--;
+
+        events[eventIndex].updateTimer(MIN_30);
+
+        return;
+    }
+
+    // check if ambulance has been reallocated during the break and send it to new depot
+    int64_t assignedDepotGridId = config.stationGridIds[ambulance->allocatedDepotIndex];
+    if (ambulance->currentGridId != assignedDepotGridId) {
+        // set to V1 to force traffic factor on travel time
+        events[eventIndex].triageImpression = "V1";
+        events[eventIndex].gridId = ambulance->currentGridId;
+
+        events[eventIndex].setType(EventType::PREPARING_DISPATCH_TO_DEPOT);
+
+        return;
+    }
+
+    events[eventIndex].removeAssignedAmbulance();
+
+    events[eventIndex].setType(EventType::NONE);
+}
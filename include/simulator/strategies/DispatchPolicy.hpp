@@ -0,0 +1,17 @@
+/**
+ * @file DispatchPolicy.hpp
+ *
+ * @copyright Copyright (c) 2024 Emergency-Optimizers
+ */
+
+#pragma once
+
+// dispatch policies from settings.txt as compile time constants, the event loop is instantiated for each combination
+template <bool prioritizeTriageValue, bool responseRestrictedValue, bool scheduleBreaksValue>
+struct DispatchPolicy {
+    // Dynamic Reassignment, ambulances dispatched to lower triage events can be reassigned
+    static constexpr bool prioritizeTriage = prioritizeTriageValue;
+    // Strategic Reserve, the last idle ambulance in a depot isn't dispatched to acute events
+    static constexpr bool responseRestricted = responseRestrictedValue;
+    static constexpr bool scheduleBreaks = scheduleBreaksValue;
+};
@@ -9,37 +9,365 @@
 /* external libraries */
 #include <vector>
 #include <random>
+#include <algorithm>
+#include <numeric>
 /* internal libraries */
 #include "simulator/strategies/DispatchEngineStrategy.hpp"
 #include "simulator/Ambulance.hpp"
+#include "simulator/AvailabilityIndex.hpp"
+#include "simulator/strategies/DispatchBuffers.hpp"
 #include "simulator/Event.hpp"
+#include "simulator/SimulationConfig.hpp"
+#include "Utils.hpp"
+#include "file-reader/ODMatrix.hpp"
 
 class RandomDispatchEngineStrategy : public DispatchEngineStrategy {
  protected:
+    template <typename Policy, typename Random>
     static bool assigningAmbulance(
-        std::mt19937& rnd,
+        Random& rnd,
         std::vector<Ambulance>& ambulances,
+        const AvailabilityIndex& availabilityIndex,
+        DispatchBuffers& buffers,
         std::vector<Event>& events,
         const int eventIndex
     );
+    template <typename Random>
     static void dispatchingToHospital(
-        std::mt19937& rnd,
-        std::vector<Ambulance>& ambulances,
+        Random& rnd,
+        const SimulationConfig& config,
         std::vector<Event>& events,
         const int eventIndex
     );
+    template <typename Random>
     static void reallocating(
-        std::mt19937& rnd,
+        Random& rnd,
+        const SimulationConfig& config,
         std::vector<Ambulance>& ambulances,
+        const std::vector<std::vector<int>>& allocations,
+        DispatchBuffers& buffers,
         std::vector<Event>& events,
         const int eventIndex
     );
 
  public:
+    template <typename Policy, typename Random>
     static bool run(
-        std::mt19937& rnd,
+        Random& rnd,
+        const SimulationConfig& config,
         std::vector<Ambulance>& ambulances,
+        const AvailabilityIndex& availabilityIndex,
+        const std::vector<std::vector<int>>& allocations,
+        DispatchBuffers& buffers,
         std::vector<Event>& events,
         const int eventIndex
     );
 };
+
+template <typename Policy, typename Random>
+bool RandomDispatchEngineStrategy::run(
+    Random& rnd,
+    const SimulationConfig& config,
+    std::vector<Ambulance>& ambulances,
+    const AvailabilityIndex& availabilityIndex,
+    const std::vector<std::vector<int>>& allocations,
+    DispatchBuffers& buffers,
+    std::vector<Event>& events,
+    const int eventIndex
+) {
+    bool sortAllEvents = false;
+
+    // process event based on type, according to RDS (Random Dispatch Strategy)
+    switch (events[eventIndex].type) {
+        case EventType::RESOURCE_APPOINTMENT:
+            sortAllEvents = assigningAmbulance<Policy>(rnd, ambulances, availabilityIndex, buffers, events, eventIndex);
+            break;
+        case EventType::PREPARING_DISPATCH_TO_SCENE:
+            preparingToDispatchToScene(rnd, events, eventIndex);
+            break;
+        case EventType::DISPATCHING_TO_SCENE:
+            dispatchingToScene(rnd, events, eventIndex);
+            break;
+        case EventType::DISPATCHING_TO_HOSPITAL:
+            dispatchingToHospital(rnd, config, events, eventIndex);
+            break;
+        case EventType::PREPARING_DISPATCH_TO_DEPOT:
+            dispatchingToDepot(rnd, config, events, eventIndex);
+            break;
+        case EventType::DISPATCHING_TO_DEPOT:
+            finishingEvent(rnd, config, events, eventIndex);
+            break;
+        case EventType::REALLOCATE:
+            // handles reallocation events
+            reallocating(rnd, config, ambulances, allocations, buffers, events, eventIndex);
+            break;
+        case EventType::START_BREAK:
+            // break events only exist if breaks are scheduled
+            if (Policy::scheduleBreaks) {
+                startingBreak(ambulances, events, eventIndex);
+            }
+            break;
+        case EventType::END_BREAK:
+            if (Policy::scheduleBreaks) {
+                endingBreak(config, events, eventIndex);
+            }
+            break;
+        case EventType::NONE:
+            break;
+    }
+
+    return sortAllEvents;
+}
+
+template <typename Policy, typename Random>
+bool RandomDispatchEngineStrategy::assigningAmbulance(
+    Random& rnd,
+    std::vector<Ambulance>& ambulances,
+    const AvailabilityIndex& availabilityIndex,
+    DispatchBuffers& buffers,
+    std::vector<Event>& events,
+    const int eventIndex
+) {
+    bool sortAllEvents = false;
+
+    // get pool of available ambulances
+    std::vector<unsigned>& availableAmbulanceIndicies = buffers.availableAmbulanceIndicies;
+    getAvailableAmbulanceIndicies<Policy>(
+        availableAmbulanceIndicies,
+        ambulances,
+        availabilityIndex,
+        events[eventIndex].triageImpression
+    );
+
+    // try to get random ambulance from pool
+    int randomAmbulanceIndex = -1;
+    while (!availableAmbulanceIndicies.empty()) {
+        int randomAvailableAmbulanceIndex = getRandomInt(rnd, 0, static_cast<int>(availableAmbulanceIndicies.size()) - 1);
+        randomAmbulanceIndex = availableAmbulanceIndicies[randomAvailableAmbulanceIndex];
+
+        if (ambulances[randomAmbulanceIndex].assignedEventId != -1) {
+            // if ambulance is already assigned to an event, approximate its location
+            // can only happen when travelling to scene (policy), or travelling to depot
+            int currentAmbulanceEventIndex = findEventIndexFromId(events, ambulances[randomAmbulanceIndex].assignedEventId);
+
+            int64_t ambulanceGridId = approximateLocation(
+                rnd,
+                ambulances[randomAmbulanceIndex].currentGridId,
+                events[currentAmbulanceEventIndex].gridId,
+                events[currentAmbulanceEventIndex].prevTimer,
+                events[eventIndex].timer,
+                events[currentAmbulanceEventIndex].triageImpression,
+                events[currentAmbulanceEventIndex].type
+            );
+
+            // if apporximated location is not available in sparse OD cost matrix, skip this ambulance
+            if (!ODMatrix::getInstance().gridIdExists(ambulanceGridId)) {
+                availableAmbulanceIndicies.erase(availableAmbulanceIndicies.begin() + randomAvailableAmbulanceIndex);
+                continue;
+            }
+
+            int incrementSeconds;
+
+            if (events[currentAmbulanceEventIndex].type == EventType::DISPATCHING_TO_DEPOT) {
+                const bool forceTrafficFactor = true;
+                incrementSeconds = ODMatrix::getInstance().getTravelTime(
+                    rnd,
+                    ambulances[randomAmbulanceIndex].currentGridId,
+                    ambulanceGridId,
+                    forceTrafficFactor,
+                    events[currentAmbulanceEventIndex].triageImpression,
+                    events[currentAmbulanceEventIndex].prevTimer
+                );
+                const bool dontUpdateTimer = true;
+                events[currentAmbulanceEventIndex].updateTimer(incrementSeconds, EventMetric::DURATION_DISPATCHING_TO_DEPOT, dontUpdateTimer);
+
+                events[currentAmbulanceEventIndex].gridId = ambulanceGridId;
+                events[currentAmbulanceEventIndex].setType(EventType::NONE);
+            } else if (events[currentAmbulanceEventIndex].type == EventType::DISPATCHING_TO_SCENE) {
+                const bool forceTrafficFactor = false;
+                incrementSeconds = ODMatrix::getInstance().getTravelTime(
+                    rnd,
+                    ambulances[randomAmbulanceIndex].currentGridId,
+                    ambulanceGridId,
+                    forceTrafficFactor,
+                    events[currentAmbulanceEventIndex].triageImpression,
+                    events[currentAmbulanceEventIndex].prevTimer
+                );
+
+                // set old event metrics to resource appointment resetting the event
+                int oldMetrics = events[currentAmbulanceEventIndex].getMetric(EventMetric::DURATION_RESOURCE_PREPARING_DEPARTURE);
+                events[currentAmbulanceEventIndex].getMetric(EventMetric::DURATION_RESOURCE_PREPARING_DEPARTURE) = 0;
+
+                events[currentAmbulanceEventIndex].getMetric(EventMetric::DURATION_RESOURCE_APPOINTMENT) += incrementSeconds + oldMetrics;
+                ambulances[randomAmbulanceIndex].timeUnavailable += incrementSeconds;
+
+                events[currentAmbulanceEventIndex].setType(EventType::RESOURCE_APPOINTMENT);
+
+                // reset timer
+                int oldEventTravelTime = ODMatrix::getInstance().getTravelTime(
+                    rnd,
+                    ambulances[randomAmbulanceIndex].currentGridId,
+                    events[currentAmbulanceEventIndex].gridId,
+                    false,
+                    events[currentAmbulanceEventIndex].triageImpression,
+                    events[currentAmbulanceEventIndex].prevTimer
+                );
+
+                events[currentAmbulanceEventIndex].timer -= oldEventTravelTime;
+                events[currentAmbulanceEventIndex].timer += incrementSeconds;
+
+                sortAllEvents = true;
+            }
+
+            events[currentAmbulanceEventIndex].removeAssignedAmbulance();
+
+            ambulances[randomAmbulanceIndex].currentGridId = ambulanceGridId;
+        }
+
+        break;
+    }
+
+    // if no ambulances are available, wait until after next event in queue is processed
+    if (availableAmbulanceIndicies.empty()) {
+        int waitTime = 60;
+
+        const bool noEventsLeft = static_cast<size_t>(eventIndex) + 1 >= events.size();
+        if (!noEventsLeft) {
+            int durationUntilNextEvent = static_cast<int>(events[eventIndex + 1].timer - events[eventIndex].timer);
+
+            waitTime = durationUntilNextEvent + 1;
+        }
+
+        events[eventIndex].updateTimer(waitTime, EventMetric::DURATION_RESOURCE_APPOINTMENT);
+
+        return sortAllEvents;
+    }
+
+    // assign ambulance to event
+    events[eventIndex].assignAmbulance(ambulances[randomAmbulanceIndex]);
+    events[eventIndex].setType(EventType::PREPARING_DISPATCH_TO_SCENE);
+    events[eventIndex].updateTimer(
+        static_cast<int>(events[eventIndex].secondsWaitResourcePreparingDeparture),
+        EventMetric::DURATION_RESOURCE_PREPARING_DEPARTURE
+    );
+
+    return sortAllEvents;
+}
+
+template <typename Random>
+void RandomDispatchEngineStrategy::dispatchingToHospital(
+    Random& rnd,
+    const SimulationConfig& config,
+    std::vector<Event>& events,
+    const int eventIndex
+) {
+    // get random hospital
+    events[eventIndex].gridId = config.stationGridIds[getRandomElement(rnd, config.hospitalIndices)];
+
+    const bool forceTrafficFactor = false;
+    int incrementSeconds = ODMatrix::getInstance().getTravelTime(
+        rnd,
+        events[eventIndex].assignedAmbulance->currentGridId,
+        events[eventIndex].gridId,
+        forceTrafficFactor,
+        events[eventIndex].triageImpression,
+        events[eventIndex].timer
+    );
+    events[eventIndex].updateTimer(incrementSeconds, EventMetric::DURATION_DISPATCHING_TO_HOSPITAL);
+
+    events[eventIndex].assignedAmbulance->currentGridId = events[eventIndex].gridId;
+
+    events[eventIndex].updateTimer(static_cast<int>(events[eventIndex].secondsWaitAvailable), EventMetric::DURATION_AT_HOSPITAL);
+
+    events[eventIndex].setType(EventType::PREPARING_DISPATCH_TO_DEPOT);
+}
+
+template <typename Random>
+void RandomDispatchEngineStrategy::reallocating(
+    Random& rnd,
+    const SimulationConfig& config,
+    std::vector<Ambulance>& ambulances,
+    const std::vector<std::vector<int>>& allocations,
+    DispatchBuffers& buffers,
+    std::vector<Event>& events,
+    const int eventIndex
+) {
+    // get depot indices
+    const std::vector<unsigned int>& depotIndices = config.getDepotIndices(config.isDayShift(events[eventIndex].timer));
+
+    // get the new allocation from reallocation event, ambulances left to place per depot are counted down in a copy
+    const std::vector<int>& allocation = allocations[events[eventIndex].allocationIndex];
+    std::vector<int>& remainingAllocation = buffers.remainingAllocation;
+    remainingAllocation.assign(allocation.begin(), allocation.end());
+
+    // create a vector of ambulance indices
+    std::vector<int>& ambulanceIndices = buffers.ambulanceIndices;
+    ambulanceIndices.resize(ambulances.size());
+    std::iota(ambulanceIndices.begin(), ambulanceIndices.end(), 0);
+
+    // remove ambulances from possible reallocation if at correct depot
+    for (size_t depotIndex = 0; depotIndex < depotIndices.size(); depotIndex++) {
+        for (size_t ambulanceIndex = 0; ambulanceIndex < ambulances.size(); ambulanceIndex++) {
+            if (remainingAllocation[depotIndex] <= 0) {
+                break;
+            }
+
+            if (ambulances[ambulanceIndex].allocatedDepotIndex == static_cast<int>(depotIndex)) {
+                ambulanceIndices.erase(
+                    std::remove(ambulanceIndices.begin(), ambulanceIndices.end(), static_cast<int>(ambulanceIndex)),
+                    ambulanceIndices.end()
+                );
+
+                remainingAllocation[depotIndex]--;
+            }
+        }
+    }
+
+    // shuffle the indicies to adhere to the random strategy
+    std::shuffle(ambulanceIndices.begin(), ambulanceIndices.end(), rnd);
+
+    // reallocate by assigning the ambulance indices to the depot according to allocation vector
+    size_t currentAmbulanceIndex = 0;
+    for (size_t depotIndex = 0; depotIndex < depotIndices.size() && currentAmbulanceIndex < ambulanceIndices.size(); depotIndex++) {
+        unsigned int allocatedToDepot = remainingAllocation[depotIndex];
+        for (unsigned int i = 0; i < allocatedToDepot && currentAmbulanceIndex < ambulanceIndices.size(); i++) {
+            /*std::cout << "Ambulance " << ambulances[ambulanceIndices[currentAmbulanceIndex]].id << ": "
+                << ambulances[ambulanceIndices[currentAmbulanceIndex]].allocatedDepotIndex
+                << " -> " << depotIndices[depotIndex] << std::endl;*/
+
+            // allocate ambulance to new depot
+            ambulances[ambulanceIndices[currentAmbulanceIndex]].reallocate(depotIndices[depotIndex]);
+
+            // branch if it isn't responding to an incident and create an event that transfers the ambulance to the new depot
+            if (ambulances[ambulanceIndices[currentAmbulanceIndex]].assignedEventId == -1) {
+                Event newEvent;
+                newEvent.id = static_cast<int>(events.size());
+                newEvent.type = EventType::PREPARING_DISPATCH_TO_DEPOT;
+                newEvent.timer = events[eventIndex].timer;
+                newEvent.prevTimer = events[eventIndex].timer;
+                newEvent.callReceived = events[eventIndex].timer;
+                newEvent.assignAmbulance(ambulances[ambulanceIndices[currentAmbulanceIndex]]);
+                // set to V1 to force traffic factor on travel time
+                newEvent.triageImpression = "V1";
+                newEvent.gridId = ambulances[ambulanceIndices[currentAmbulanceIndex]].currentGridId;
+                newEvent.utility = true;
+                newEvent.randomStreamKey = deriveStreamKey(
+                    events[eventIndex].randomStreamKey,
+                    static_cast<uint64_t>(ambulances[ambulanceIndices[currentAmbulanceIndex]].id)
+                );
+
+                events.insert(events.begin() + eventIndex + 1, newEvent);
+            }
+
+            currentAmbulanceIndex++;
+        }
+    }
+
+    // increment allocation index for each ambulance
+    for (size_t ambulanceIndex = 0; ambulanceIndex < ambulances.size(); ambulanceIndex++) {
+        ambulances[ambulanceIndex].currentAllocationIndex++;
+    }
+
+    // set the type to none so it doesn't trigger again
+    events[eventIndex].setType(EventType::NONE);
+}
@@ -20,6 +20,7 @@
 #include "simulator/AmbulanceAllocator.hpp"
 #include "simulator/Simulator.hpp"
 #include "simulator/MonteCarloSimulator.hpp"
+#include "simulator/ScenarioCache.hpp"
 #include "heuristics/Individual.hpp"
 #include "heuristics/PopulationGA.hpp"
 #include "heuristics/PopulationNSGA2.hpp"
@@ -36,38 +37,64 @@ int main() {
     Settings::LoadSettings();
     Traffic::getInstance();
     Stations::getInstance();
-    Incidents::getInstance();
     ODMatrix::getInstance();
 
-    std::cout << std::endl;
-
-    // generate events
-    MonteCarloSimulator monteCarloSim;
-    std::vector<Event> events = monteCarloSim.generateEvents();
+    const HeuristicType heuristic = Settings::get<HeuristicType>("HEURISTIC");
+    // a single simulator run can generate its events while simulating instead of up front
+    const int rollingHorizonDays = Settings::get<int>("ROLLING_HORIZON_DAYS");
+    const bool streamEvents = heuristic == HeuristicType::NONE && (Settings::get<bool>("STREAM_EVENTS") || rollingHorizonDays > 0);
+
+    // events and the additional scenarios heuristics average their objectives over,
+    // reused from the scenario cache if generated before with the same settings and incidents data
+    std::vector<Event> events;
+    std::vector<std::vector<Event>> scenarios;
+    const ScenarioCache scenarioCache;
+    if (!streamEvents && !scenarioCache.load(events, scenarios)) {
+        // incidents are only needed for generating events
+        Incidents::getInstance();
+
+        std::cout << std::endl;
+
+        MonteCarloSimulator monteCarloSim;
+        events = monteCarloSim.generateEvents();
+        scenarios = monteCarloSim.generateScenarios(Settings::get<int>("NUM_SCENARIOS") - 1);
+
+        scenarioCache.save(events, scenarios);
+    }
 
     std::cout << std::endl;
 
     // run heuristic specified in settings.txt (can also run simulator once or an experiment defined in Programs.hpp)
-    const HeuristicType heuristic = Settings::get<HeuristicType>("HEURISTIC");
     switch (heuristic) {
         case HeuristicType::NONE:
-            runSimulatorOnce(events);
+            if (rollingHorizonDays > 0) {
+                Incidents::getInstance();
+
+                runRollingHorizon(rollingHorizonDays);
+            } else if (streamEvents) {
+                Incidents::getInstance();
+
+                const MonteCarloSimulator monteCarloSim;
+                runSimulatorStreamed(monteCarloSim);
+            } else {
+                runSimulatorOnce(events);
+            }
 
             break;
         case HeuristicType::GA:
-            runGeneticAlgorithm(events);
+            runGeneticAlgorithm(events, scenarios);
 
             break;
         case HeuristicType::NSGA2:
-            runNSGA2(events);
+            runNSGA2(events, scenarios);
 
             break;
         case HeuristicType::MA:
-            runMemeticAlgorithm(events);
+            runMemeticAlgorithm(events, scenarios);
 
             break;
         case HeuristicType::MEMETIC_NSGA2:
-            runMemeticNSGA2(events);
+            runMemeticNSGA2(events, scenarios);
 
             break;
         case HeuristicType::CUSTOM:
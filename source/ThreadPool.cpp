@@ -0,0 +1,77 @@
+/**
+ * @file ThreadPool.cpp
+ *
+ * @copyright Copyright (c) 2024 Emergency-Optimizers
+ */
+
+/* internal libraries */
+#include "ThreadPool.hpp"
+
+ThreadPool::ThreadPool(const size_t numThreads) {
+    workers.reserve(numThreads);
+    for (size_t threadIndex = 0; threadIndex < numThreads; threadIndex++) {
+        workers.emplace_back(&ThreadPool::work, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    tasksAvailable.notify_all();
+
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::run(const size_t newNumTasks, const std::function<void(const size_t)>& newTask) {
+    if (newNumTasks == 0) {
+        return;
+    }
+
+    // run on the calling thread if there are no workers
+    if (workers.empty()) {
+        for (size_t taskIndex = 0; taskIndex < newNumTasks; taskIndex++) {
+            newTask(taskIndex);
+        }
+
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex);
+    task = &newTask;
+    numTasks = newNumTasks;
+    nextTaskIndex = 0;
+    numTasksFinished = 0;
+    tasksAvailable.notify_all();
+
+    // block until the whole batch is done so the task and its captures outlive every call
+    tasksFinished.wait(lock, [this]() { return numTasksFinished == numTasks; });
+    task = nullptr;
+    numTasks = 0;
+    nextTaskIndex = 0;
+}
+
+void ThreadPool::work() {
+    std::unique_lock<std::mutex> lock(mutex);
+
+    while (true) {
+        tasksAvailable.wait(lock, [this]() { return stopping || nextTaskIndex < numTasks; });
+        if (stopping) {
+            return;
+        }
+
+        const size_t taskIndex = nextTaskIndex++;
+        const std::function<void(const size_t)>& currentTask = *task;
+
+        lock.unlock();
+        currentTask(taskIndex);
+        lock.lock();
+
+        if (++numTasksFinished == numTasks) {
+            tasksFinished.notify_one();
+        }
+    }
+}
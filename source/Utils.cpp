@@ -13,12 +13,15 @@
 #include <numeric>
 #include <chrono>
 #include <filesystem>
+#include <thread>
 /* internal libraries */
 #include "Utils.hpp"
 #include "Constants.hpp"
+#include "WeightedSampler.hpp"
+#include "file-reader/Settings.hpp"
 #include "file-reader/ODMatrix.hpp"
-#include "file-reader/Incidents.hpp"
 #include "file-reader/Stations.hpp"
+#include "simulator/SimClock.hpp"
 
 ValueType toInt(const std::string& str) {
     return std::stoi(str);
@@ -259,92 +262,27 @@ double timeDifferenceInSeconds(std::tm& time1, std::tm& time2) {
     return std::difftime(t2, t1);
 }
 
-std::vector<unsigned> getAvailableAmbulanceIndicies(
-    std::vector<Ambulance>& ambulances,
-    const std::vector<Event>& events,
-    const time_t& currentTime,
-    const std::string& currentEventTriageImpression
-) {
-    std::vector<unsigned> availableAmbulanceIndicies;
-
-    // populates pool with available ambulances
-    for (unsigned i = 0; i < ambulances.size(); i++) {
-        int eventIndex = -1;
-
-        // find event index if ambulance is assigned to an event
-        if (ambulances[i].assignedEventId != -1) {
-            eventIndex = findEventIndexFromId(events, ambulances[i].assignedEventId);
-        }
+bool isLeapYear(const int year) {
+    return (year % 4 == 0) && ((year % 100 != 0) || (year % 400 == 0));
+}
 
-        // check with ambulance if it is available
-        if (ambulances[i].isAvailable(events, ambulances, eventIndex, currentTime, currentEventTriageImpression)) {
-            availableAmbulanceIndicies.push_back(i);
-        }
-    }
+int dayOfYear(const int year, const int month, const int day) {
+    // days before each month in a common year
+    static const int daysBeforeMonth[12] = {0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334};
 
-    return availableAmbulanceIndicies;
+    return daysBeforeMonth[month - 1] + (month > 2 && isLeapYear(year) ? 1 : 0) + day - 1;
 }
 
-int calculateDayDifference(const std::tm& baseDate, const int targetMonth, const int targetDay) {
+int calculateDayDifference(const int baseYear, const int baseDayOfYear, const int targetMonth, const int targetDay) {
     // method used in MCS distribution generations
     // needed to find out which weight to use for date based on distance from target date (defined in settings.txt)
-    int year = baseDate.tm_year;
-    bool isLeapYear = (year % 4 == 0) && ((year % 100 != 0) || (year % 400 == 0));
-    int totalDaysInYear = isLeapYear ? 365 : 364;
-
-    std::tm baseDateNormalized = baseDate;
-    baseDateNormalized.tm_hour = 0;
-    baseDateNormalized.tm_min = 0;
-    baseDateNormalized.tm_sec = 0;
-    mktime(&baseDateNormalized);
-
-    // create tm structure for the target date in the same year as the base date
-    std::tm targetDate = {0};
-    targetDate.tm_year = year;
-    targetDate.tm_mon = targetMonth - 1;
-    targetDate.tm_mday = targetDay;
-    targetDate.tm_hour = 0;
-    targetDate.tm_min = 0;
-    targetDate.tm_sec = 0;
-    mktime(&targetDate);
-
-    int targetDayOfYear = targetDate.tm_yday;
-    int baseDayOfYear = baseDateNormalized.tm_yday;
-    int dayDiff = 0;
-
-    if (targetDayOfYear == baseDayOfYear) {
-        return 0;
-    }
-
-    while (true) {
-        if (targetDayOfYear == baseDayOfYear) {
-            break;
-        }
-        if (++baseDayOfYear > totalDaysInYear) {
-            baseDayOfYear = 0;
-        }
-        dayDiff++;
-    }
+    const int daysInYear = isLeapYear(baseYear) ? 366 : 365;
+    const int targetDayOfYear = dayOfYear(baseYear, targetMonth, targetDay);
 
-    targetDayOfYear = targetDate.tm_yday;
-    baseDayOfYear = baseDateNormalized.tm_yday;
-    int newDayDiff = 0;
+    // shortest distance around the year between the base day and the target day in the same year
+    const int forwardDays = ((targetDayOfYear - baseDayOfYear) % daysInYear + daysInYear) % daysInYear;
 
-    while (dayDiff != newDayDiff) {
-        if (targetDayOfYear == baseDayOfYear) {
-            break;
-        }
-        if (--baseDayOfYear < 0) {
-            baseDayOfYear = totalDaysInYear;
-        }
-        newDayDiff++;
-    }
-
-    if (dayDiff > newDayDiff) {
-        dayDiff = newDayDiff;
-    }
-
-    return dayDiff;
+    return std::min(forwardDays, daysInYear - forwardDays);
 }
 
 int weightedLottery(
@@ -352,75 +290,8 @@ int weightedLottery(
     const std::vector<double>& weights,
     const std::vector<std::pair<int, int>>& ranges
 ) {
-    if (weights.empty()) {
-        return -1;
-    }
-
-    if (weights.size() == 1) {
-        return 0;
-    }
-
-    std::vector<double> adjustedWeights;
-
-    // used for limiting lottery to only a specific section of the vector
-    if (ranges.empty()) {
-        // if ranges is empty, use the entire weights vector
-        adjustedWeights = weights;
-    } else {
-        // otherwise, process each specified range
-        for (const auto& range : ranges) {
-            int beginIndex = std::max(0, range.first);
-            int endIndex = std::min(static_cast<int>(weights.size()) - 1, range.second);
-
-            if (beginIndex <= endIndex) {
-                adjustedWeights.insert(
-                    adjustedWeights.end(),
-                    weights.begin() + beginIndex,
-                    weights.begin() + endIndex + 1
-                );
-            }
-        }
-    }
-
-    // create a partial sum of the adjusted weights
-    std::vector<double> cumulativeWeights(adjustedWeights.size());
-    std::partial_sum(adjustedWeights.begin(), adjustedWeights.end(), cumulativeWeights.begin());
-
-    // generate a random number in the adjusted range
-    std::uniform_real_distribution<> dist(0.0, cumulativeWeights.back());
-    auto it = std::lower_bound(cumulativeWeights.begin(), cumulativeWeights.end(), dist(rnd));
-    int indexInAdjustedWeights = static_cast<int>(std::distance(cumulativeWeights.begin(), it));
-
-    // for the default case (full range), the adjusted index is the final result
-    if (ranges.empty()) {
-        return indexInAdjustedWeights;
-    }
-
-    // adjust the index to map back to the original weights vector for specified ranges
-    int originalIndex = 0;
-    for (const auto& range : ranges) {
-        int rangeSize = range.second - range.first + 1;
-        if (indexInAdjustedWeights < rangeSize) {
-            originalIndex += range.first + indexInAdjustedWeights;
-            break;
-        } else {
-            indexInAdjustedWeights -= rangeSize;
-        }
-    }
-
-    return originalIndex;
-}
-
-int getRandomInt(std::mt19937& rnd, int min, int max) {
-    if (min > max) {
-        int tmp = min;
-        min = max;
-        max = tmp;
-    }
-
-    std::uniform_int_distribution<> dist(min, max);
-
-    return dist(rnd);
+    // one-off draw, use a WeightedSampler directly when drawing repeatedly from the same weights
+    return WeightedSampler(weights, ranges).sample(rnd);
 }
 
 void writeEvents(const std::string& dirName, std::vector<Event>& events, std::string fileName) {
@@ -436,17 +307,21 @@ void writeEvents(const std::string& dirName, std::vector<Event>& events, std::st
 
     // sort events
     std::sort(events.begin(), events.end(), [](const Event& a, const Event& b) {
-        std::tm aTimeStruct = a.callReceived;
-        std::tm bTimeStruct = b.callReceived;
-
-        time_t aTime = std::mktime(&aTimeStruct);
-        time_t bTime = std::mktime(&bTimeStruct);
-
-        return aTime < bTime;
+        return a.callReceived < b.callReceived;
     });
 
     // write CSV header
-    outFile
+    writeEventsHeader(outFile);
+
+    for (const Event& event : events) {
+        writeEvent(outFile, event);
+    }
+
+    outFile.close();
+}
+
+void writeEventsHeader(std::ostream& outStream) {
+    outStream
         << "time_call_received" << ","
         << "triage_impression_during_call" << ","
         << "grid_id" << ","
@@ -462,31 +337,30 @@ void writeEvents(const std::string& dirName, std::vector<Event>& events, std::st
         << "duration_dispatching_to_hospital" << ","
         << "duration_at_hospital" << ","
         << "duration_dispatching_to_depot" << std::endl;
+}
 
-    for (Event& event : events) {
-        if (event.utility) {
-            continue;
-        }
-        // write each metric to the CSV
-        outFile
-            << tmToString(event.callReceived) << ","
-            << event.triageImpression << ","
-            << std::to_string(event.incidentGridId) << ","
-            << (Incidents::getInstance().gridIdUrban[event.incidentGridId] ? "True" : "False") << ","
-            << std::to_string(event.allocationIndex) << ","
-            << std::to_string(event.ambulanceIdResponsible) << ","
-            << std::to_string(event.depotIndexResponsible) << ","
-            << (event.metrics["duration_incident_creation"] != -1 ? std::to_string(event.metrics["duration_incident_creation"]) : "") << ","
-            << (event.metrics["duration_resource_appointment"] != -1 ? std::to_string(event.metrics["duration_resource_appointment"]) : "") << ","
-            << (event.metrics["duration_resource_preparing_departure"] != -1 ? std::to_string(event.metrics["duration_resource_preparing_departure"]) : "") << ","
-            << (event.metrics["duration_dispatching_to_scene"] != -1 ? std::to_string(event.metrics["duration_dispatching_to_scene"]) : "") << ","
-            << (event.metrics["duration_at_scene"] != -1 ? std::to_string(event.metrics["duration_at_scene"]) : "") << ","
-            << (event.metrics["duration_dispatching_to_hospital"] != -1 ? std::to_string(event.metrics["duration_dispatching_to_hospital"]) : "") << ","
-            << (event.metrics["duration_at_hospital"] != -1 ? std::to_string(event.metrics["duration_at_hospital"]) : "") << ","
-            << (event.metrics["duration_dispatching_to_depot"] != -1 ? std::to_string(event.metrics["duration_dispatching_to_depot"]) : "") << std::endl;
+void writeEvent(std::ostream& outStream, const Event& event) {
+    if (event.utility) {
+        return;
     }
 
-    outFile.close();
+    // write each metric to the CSV
+    outStream
+        << SimClock::getInstance().toString(event.callReceived) << ","
+        << event.triageImpression << ","
+        << std::to_string(event.incidentGridId) << ","
+        << (event.urban ? "True" : "False") << ","
+        << std::to_string(event.allocationIndex) << ","
+        << std::to_string(event.ambulanceIdResponsible) << ","
+        << std::to_string(event.depotIndexResponsible) << ","
+        << (event.getMetric(EventMetric::DURATION_INCIDENT_CREATION) != -1 ? std::to_string(event.getMetric(EventMetric::DURATION_INCIDENT_CREATION)) : "") << ","
+        << (event.getMetric(EventMetric::DURATION_RESOURCE_APPOINTMENT) != -1 ? std::to_string(event.getMetric(EventMetric::DURATION_RESOURCE_APPOINTMENT)) : "") << ","
+        << (event.getMetric(EventMetric::DURATION_RESOURCE_PREPARING_DEPARTURE) != -1 ? std::to_string(event.getMetric(EventMetric::DURATION_RESOURCE_PREPARING_DEPARTURE)) : "") << ","
+        << (event.getMetric(EventMetric::DURATION_DISPATCHING_TO_SCENE) != -1 ? std::to_string(event.getMetric(EventMetric::DURATION_DISPATCHING_TO_SCENE)) : "") << ","
+        << (event.getMetric(EventMetric::DURATION_AT_SCENE) != -1 ? std::to_string(event.getMetric(EventMetric::DURATION_AT_SCENE)) : "") << ","
+        << (event.getMetric(EventMetric::DURATION_DISPATCHING_TO_HOSPITAL) != -1 ? std::to_string(event.getMetric(EventMetric::DURATION_DISPATCHING_TO_HOSPITAL)) : "") << ","
+        << (event.getMetric(EventMetric::DURATION_AT_HOSPITAL) != -1 ? std::to_string(event.getMetric(EventMetric::DURATION_AT_HOSPITAL)) : "") << ","
+        << (event.getMetric(EventMetric::DURATION_DISPATCHING_TO_DEPOT) != -1 ? std::to_string(event.getMetric(EventMetric::DURATION_DISPATCHING_TO_DEPOT)) : "") << std::endl;
 }
 
 void writeGenotype(const std::string& dirName, const std::vector<std::vector<int>>& genotype, std::string fileName) {
@@ -502,7 +376,11 @@ void writeGenotype(const std::string& dirName, const std::vector<std::vector<int
 
     // write CSV header
     const size_t numAllocations = genotype.size();
-    const size_t numDepots = genotype[0].size();
+    // day and night shift allocations of a rolling horizon have different numbers of depots
+    size_t numDepots = 0;
+    for (const std::vector<int>& allocation : genotype) {
+        numDepots = std::max(numDepots, allocation.size());
+    }
 
     outFile << "allocation_index";
 
@@ -516,7 +394,7 @@ void writeGenotype(const std::string& dirName, const std::vector<std::vector<int
     for (size_t i = 0; i < numAllocations; ++i) {
         outFile << std::to_string(i);
 
-        for (size_t j = 0; j < numDepots; ++j) {
+        for (size_t j = 0; j < genotype[i].size(); ++j) {
             outFile << "," << genotype[i][j];
         }
 
@@ -643,6 +521,17 @@ bool getRandomBool(std::mt19937& rnd) {
     return getRandomDouble(rnd) < 0.5;
 }
 
+int getNumThreads() {
+    int numThreads = Settings::get<int>("NUM_THREADS");
+
+    // use all hardware threads if not specified, hardware concurrency may be unknown (0)
+    if (numThreads < 1) {
+        numThreads = static_cast<int>(std::thread::hardware_concurrency());
+    }
+
+    return std::max(numThreads, 1);
+}
+
 double calculateMean(const std::vector<int>& numbers) {
     double sum = 0.0;
 
@@ -685,54 +574,6 @@ int64_t utmToId(const std::pair<int, int>& utm, const int cellSize, const int of
     return 20000000000000 + (xCorner * 10000000) + yCorner;
 }
 
-int64_t approximateLocation(
-    std::mt19937& rnd,
-    const int64_t& startId,
-    const int64_t& goalId,
-    const time_t& timeAtStart,
-    const time_t& timeNow,
-    const std::string& triage,
-    const EventType eventType
-) {
-    // if ambulance is dispatching to depot, apply traffic, otherwise check triage
-    bool forceTrafficFactor = true;
-    if (eventType == EventType::DISPATCHING_TO_SCENE) {
-        forceTrafficFactor = false;
-    }
-
-    int timeToReachGoal = ODMatrix::getInstance().getTravelTime(
-        rnd,
-        startId,
-        goalId,
-        forceTrafficFactor,
-        triage,
-        timeAtStart
-    );
-
-    // use interpolation to find approximate location
-    time_t timeTravelled = timeNow - timeAtStart;
-
-    double proportion = static_cast<double>(timeTravelled) / static_cast<double>(timeToReachGoal);
-
-    std::pair<int, int> utmStart = idToUtm(startId);
-    std::pair<int, int> utmGoal = idToUtm(goalId);
-
-    std::pair<int, int> utmInterpolated = {
-        static_cast<int>(static_cast<double>(utmStart.first) + static_cast<double>(utmGoal.first - utmStart.first) * proportion),
-        static_cast<int>(static_cast<double>(utmStart.second) + static_cast<double>(utmGoal.second - utmStart.second) * proportion)
-    };
-
-    int64_t approximatedGridId = utmToId(utmInterpolated);
-
-    /*std::cout
-        << startId << " -> " << goalId << " = " << approximatedGridId << " ("
-        << proportion * 100 << "% ("
-        << timeTravelled << "->" << timeToReachGoal
-        << "))" << std::endl;*/
-
-    return approximatedGridId;
-}
-
 int findEventIndexFromId(const std::vector<Event>& events, const int id) {
     for (int i = 0; i < events.size(); i++) {
         if (events[i].id == id) {
@@ -744,8 +585,7 @@ int findEventIndexFromId(const std::vector<Event>& events, const int id) {
 }
 
 bool isDayShift(const time_t& eventTimer, const int dayShiftStart, const int dayShiftEnd) {
-    std::tm timeInfo = getLocalTime(eventTimer);
-    int hour = timeInfo.tm_hour;
+    int hour = SimClock::getInstance().getHour(eventTimer);
 
     return hour >= dayShiftStart && hour <= dayShiftEnd;
 }
@@ -754,11 +594,14 @@ std::string eventTypeToString(EventType eventType) {
     switch (eventType) {
         case EventType::NONE: return "NONE";
         case EventType::RESOURCE_APPOINTMENT: return "RESOURCE_APPOINTMENT";
+        case EventType::PREPARING_DISPATCH_TO_SCENE: return "PREPARING_DISPATCH_TO_SCENE";
         case EventType::DISPATCHING_TO_SCENE: return "DISPATCHING_TO_SCENE";
         case EventType::DISPATCHING_TO_HOSPITAL: return "DISPATCHING_TO_HOSPITAL";
         case EventType::PREPARING_DISPATCH_TO_DEPOT: return "PREPARING_DISPATCH_TO_DEPOT";
         case EventType::DISPATCHING_TO_DEPOT: return "DISPATCHING_TO_DEPOT";
         case EventType::REALLOCATE: return "REALLOCATE";
+        case EventType::START_BREAK: return "START_BREAK";
+        case EventType::END_BREAK: return "END_BREAK";
         default: return "UNKNOWN";
     }
 }
@@ -792,7 +635,7 @@ double averageResponseTime(
         }
 
         // limit to specific triage and urbanization
-        if (event.triageImpression != triageImpression || Incidents::getInstance().gridIdUrban[event.incidentGridId] != urban) {
+        if (event.triageImpression != triageImpression || event.urban != urban) {
             continue;
         }
 
@@ -841,7 +684,7 @@ double responseTimeViolations(
         // get response time and check if it violates the guidelines
         int responseTime = simulatedEvents[eventIndex].getResponseTime();
 
-        bool urban = Incidents::getInstance().gridIdUrban[simulatedEvents[eventIndex].incidentGridId];
+        bool urban = simulatedEvents[eventIndex].urban;
         std::string triage = simulatedEvents[eventIndex].triageImpression;
 
         if (triage == "A") {
@@ -871,6 +714,73 @@ double responseTimeViolations(
     return totalViolations / totalEvents;
 }
 
+std::vector<double> responseTimeViolationsPerDepot(
+    std::vector<Event>& simulatedEvents,
+    const int allocationIndex,
+    const int numDepots
+) {
+    // same result as calling responseTimeViolations for each depot, but in a single pass over the events
+    // events handled by other depots count towards the total, V1 events only count for the other depots
+    double totalEvents = 0.0;
+    std::vector<double> depotViolations(numDepots, 0.0);
+    std::vector<double> depotEventsV1(numDepots, 0.0);
+
+    const int urbanAcuteResponseTimeGoalSeconds = 720;
+    const int ruralAcuteResponseTimeGoalSeconds = 1500;
+    const int urbanUrgentResponseTimeGoalSeconds = 1800;
+    const int ruralUrgentResponseTimeGoalSeconds = 2400;
+
+    for (size_t eventIndex = 0; eventIndex < simulatedEvents.size(); eventIndex++) {
+        if (simulatedEvents[eventIndex].utility) {
+            continue;
+        }
+
+        if (allocationIndex != -1 && simulatedEvents[eventIndex].allocationIndex != allocationIndex) {
+            continue;
+        }
+
+        totalEvents++;
+
+        const int depotIndex = simulatedEvents[eventIndex].depotIndexResponsible;
+        if (depotIndex < 0 || depotIndex >= numDepots) {
+            continue;
+        }
+
+        int responseTime = simulatedEvents[eventIndex].getResponseTime();
+
+        bool urban = simulatedEvents[eventIndex].urban;
+        const std::string& triage = simulatedEvents[eventIndex].triageImpression;
+
+        if (triage == "A") {
+            if (urban && responseTime > urbanAcuteResponseTimeGoalSeconds) {
+                depotViolations[depotIndex]++;
+            } else if (!urban && responseTime > ruralAcuteResponseTimeGoalSeconds) {
+                depotViolations[depotIndex]++;
+            }
+        } else if (triage == "H") {
+            if (urban && responseTime > urbanUrgentResponseTimeGoalSeconds) {
+                depotViolations[depotIndex]++;
+            } else if (!urban && responseTime > ruralUrgentResponseTimeGoalSeconds) {
+                depotViolations[depotIndex]++;
+            }
+        } else if (triage == "V1") {
+            depotEventsV1[depotIndex]++;
+        }
+    }
+
+    // returns percentage of incidents that violated guidelines for each depot
+    std::vector<double> depotPercentageViolations(numDepots, 0.0);
+    for (int depotIndex = 0; depotIndex < numDepots; depotIndex++) {
+        const double depotTotalEvents = totalEvents - depotEventsV1[depotIndex];
+
+        if (depotTotalEvents != 0.0) {
+            depotPercentageViolations[depotIndex] = depotViolations[depotIndex] / depotTotalEvents;
+        }
+    }
+
+    return depotPercentageViolations;
+}
+
 double responseTimeViolationsUrban(
     std::vector<Event>& simulatedEvents,
     const bool checkUrban,
@@ -895,7 +805,7 @@ double responseTimeViolationsUrban(
             continue;
         }
 
-        bool urban = Incidents::getInstance().gridIdUrban[simulatedEvents[eventIndex].incidentGridId];
+        bool urban = simulatedEvents[eventIndex].urban;
         if (urban != checkUrban) {
             continue;
         }
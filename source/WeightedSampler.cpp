@@ -0,0 +1,60 @@
+/**
+ * @file WeightedSampler.cpp
+ *
+ * @copyright Copyright (c) 2024 Emergency-Optimizers
+ */
+
+/* external libraries */
+#include <algorithm>
+/* internal libraries */
+#include "WeightedSampler.hpp"
+
+WeightedSampler::WeightedSampler(
+    const std::vector<double>& weights,
+    const std::vector<std::pair<int, int>>& ranges
+) : numWeights(static_cast<int>(weights.size())) {
+    // a single weight is always drawn and needs no table
+    if (numWeights < 2) {
+        return;
+    }
+
+    // used for limiting lottery to only a specific section of the vector
+    if (!ranges.empty()) {
+        for (const auto& range : ranges) {
+            int beginIndex = std::max(0, range.first);
+            int endIndex = std::min(numWeights - 1, range.second);
+
+            for (int index = beginIndex; index <= endIndex; index++) {
+                originalIndices.push_back(index);
+            }
+        }
+    }
+
+    // create a partial sum of the weights within ranges
+    double totalWeight = 0.0;
+    const int numCumulativeWeights = ranges.empty() ? numWeights : static_cast<int>(originalIndices.size());
+    cumulativeWeights.reserve(numCumulativeWeights);
+    for (int index = 0; index < numCumulativeWeights; index++) {
+        totalWeight += weights[ranges.empty() ? index : originalIndices[index]];
+        cumulativeWeights.push_back(totalWeight);
+    }
+}
+
+int WeightedSampler::sample(std::mt19937& rnd) const {
+    if (numWeights == 1) {
+        return 0;
+    }
+
+    // no weights, or no weights within the ranges
+    if (cumulativeWeights.empty()) {
+        return -1;
+    }
+
+    // generate a random number in the cumulative range
+    std::uniform_real_distribution<> dist(0.0, cumulativeWeights.back());
+    auto it = std::lower_bound(cumulativeWeights.begin(), cumulativeWeights.end(), dist(rnd));
+    int index = static_cast<int>(std::distance(cumulativeWeights.begin(), it));
+
+    // map back to the original weights vector for specified ranges
+    return originalIndices.empty() ? index : originalIndices[index];
+}
@@ -6,9 +6,11 @@
 
 /* external libraries */
 #include <iostream>
+#include <algorithm>
 /* internal libraries */
 #include "file-reader/Incidents.hpp"
 #include "file-reader/Settings.hpp"
+#include "Utils.hpp"
 
 Incidents::Incidents() {
     // define the schema: header and function that converts string to specific type
@@ -107,16 +109,66 @@ Incidents::Incidents() {
         {"total_V1_incidents_hour_23", toInt},
     };
 
-    // hard coded path, important to follow steps in README.md to be able to run
-    loadFromFile("../../Data-Processing/data/enhanced/oslo/incidents.csv", "Loading incidents data");
+    loadFromFile(getFilename(), "Loading incidents data");
 
-    // cache each grid id's urbanization
+    // day of each call, so day distances need no calendar conversions per lookup
+    const int timeCallReceivedColumn = getColumnIndex("time_call_received");
+    callYears.resize(size());
+    callDaysOfYear.resize(size());
     for (int i = 0; i < size(); i++) {
-        int64_t grid_id = get<int64_t>("grid_id", i);
-        int64_t urban_settlement = get<bool>(Settings::get<std::string>("URBAN_METHOD"), i);
+        const std::tm timeCallReceived = get<std::optional<std::tm>>(timeCallReceivedColumn, i).value();
 
-        gridIdUrban[grid_id] = urban_settlement;
+        callYears[i] = timeCallReceived.tm_year + 1900;
+        callDaysOfYear[i] = dayOfYear(callYears[i], timeCallReceived.tm_mon + 1, timeCallReceived.tm_mday);
+
+        firstIndexOfDay.insert({{callYears[i], callDaysOfYear[i]}, i});
+    }
+
+    // find bounding box of all incident grid cells
+    const std::string urbanMethod = Settings::get<std::string>("URBAN_METHOD");
+    int maxEasting = 0;
+    int maxNorthing = 0;
+    for (int i = 0; i < size(); i++) {
+        std::pair<int, int> utm = idToUtm(get<int64_t>("grid_id", i));
+
+        minEasting = i == 0 ? utm.first : std::min(minEasting, utm.first);
+        minNorthing = i == 0 ? utm.second : std::min(minNorthing, utm.second);
+        maxEasting = i == 0 ? utm.first : std::max(maxEasting, utm.first);
+        maxNorthing = i == 0 ? utm.second : std::max(maxNorthing, utm.second);
     }
+
+    numCellsEasting = size() == 0 ? 0 : (maxEasting - minEasting) / cellSize + 1;
+    numCellsNorthing = size() == 0 ? 0 : (maxNorthing - minNorthing) / cellSize + 1;
+
+    // cache each grid cell's urbanization
+    urbanCells.assign(numCellsEasting * numCellsNorthing, false);
+    for (int i = 0; i < size(); i++) {
+        urbanCells[getCellIndex(get<int64_t>("grid_id", i))] = get<bool>(urbanMethod, i);
+    }
+}
+
+int Incidents::getCellIndex(const int64_t& gridId) const {
+    std::pair<int, int> utm = idToUtm(gridId);
+
+    const int cellEasting = (utm.first - minEasting) / cellSize;
+    const int cellNorthing = (utm.second - minNorthing) / cellSize;
+    const bool insideBoundingBox = utm.first >= minEasting && utm.second >= minNorthing
+        && cellEasting < numCellsEasting && cellNorthing < numCellsNorthing;
+
+    return insideBoundingBox ? cellEasting * numCellsNorthing + cellNorthing : -1;
+}
+
+bool Incidents::isUrban(const int64_t& gridId) const {
+    const int cellIndex = getCellIndex(gridId);
+
+    // cells without any incidents are treated as rural
+    return cellIndex != -1 && urbanCells[cellIndex];
+}
+
+int Incidents::getFirstIndexOfDay(const int year, const int dayOfYear) const {
+    const auto it = firstIndexOfDay.find({year, dayOfYear});
+
+    return it != firstIndexOfDay.end() ? it->second : -1;
 }
 
 double Incidents::timeDifferenceBetweenHeaders(const std::string& header1, const std::string& header2, const int index) {
@@ -131,9 +183,7 @@ std::vector<int> Incidents::rowsWithinTimeFrame(const int month, const int day,
 
     // gets all indices within window size to be used in the MCS distribution generation
     for (int i = 0; i < rows.size(); i++) {
-        std::tm timeCallReceived = get<std::optional<std::tm>>("time_call_received", i).value();
-
-        int dayDiff = calculateDayDifference(timeCallReceived, month, day);
+        int dayDiff = calculateDayDifference(callYears[i], callDaysOfYear[i], month, day);
 
         bool withinWindowSize = dayDiff <= windowSize;
 
@@ -75,20 +75,22 @@ void ODMatrix::loadFromFile(const std::string& filename) {
     file.close();
 }
 
-int ODMatrix::getTravelTime(
-    std::mt19937& rnd,
+double ODMatrix::getExpectedTravelTime(
     const int64_t& id1,
     const int64_t& id2,
     const bool forceTrafficFactor,
     const std::string& triage,
     const time_t& time
 ) {
-    if (idToIndexMap.find(id1) == idToIndexMap.end() || idToIndexMap.find(id2) == idToIndexMap.end()) {
+    // only lookups, the map is shared between simulators running in parallel
+    const auto index1 = idToIndexMap.find(id1);
+    const auto index2 = idToIndexMap.find(id2);
+    if (index1 == idToIndexMap.end() || index2 == idToIndexMap.end()) {
         std::cerr << "Invalid IDs\n";
-        return 0;
+        return -1.0;
     }
 
-    double travelTime = static_cast<double>(matrix[idToIndexMap[id1]][idToIndexMap[id2]]);
+    double travelTime = static_cast<double>(matrix[index1->second][index2->second]);
 
     // set to 60 seconds if no travel time is given
     if (travelTime == 0) {
@@ -107,11 +109,7 @@ int ODMatrix::getTravelTime(
         travelTime *= acuteFactor;
     }
 
-    // add noise
-    double noise = normalDist(rnd);
-    travelTime *= noise;
-
-    return static_cast<int>(floor(travelTime));
+    return travelTime;
 }
 
 bool ODMatrix::gridIdExists(const int64_t& id) {
@@ -36,10 +36,11 @@ Stations::Stations() {
 
 std::vector<unsigned> Stations::getDepotIndices(const bool useExtraDepots) {
     std::vector<unsigned> depotIndices;
+    const int skipStationIndex = Settings::get<int>("SKIP_STATION_INDEX");
 
     // gets all indices for depots in the depots.csv file (the file contains both depots and hospitals)
     for (int i = 0; i < size(); i++) {
-        if (Settings::get<int>("SKIP_STATION_INDEX") == i) {
+        if (skipStationIndex == i) {
             continue;
         }
 
@@ -8,6 +8,7 @@
 #include <iostream>
 /* internal libraries */
 #include "file-reader/Traffic.hpp"
+#include "simulator/SimClock.hpp"
 
 Traffic::Traffic() {
     // define the schema: header and function that converts string to specific type
@@ -25,11 +26,9 @@ Traffic::Traffic() {
 }
 
 double Traffic::getTrafficFactor(const time_t& time) {
-    std::tm localTime = getLocalTime(time);
-
     const char* daysOfWeek[] = {"Sunday", "Monday", "Tuesday", "Wednesday", "Thursday", "Friday", "Saturday"};
 
     // returns the traffic factor based on day of week, and hour of day
     // traffic factor is used with the OD cost matrix to increase realism
-    return get<double>(daysOfWeek[localTime.tm_wday], localTime.tm_hour);
+    return get<double>(daysOfWeek[SimClock::getInstance().getDayOfWeek(time)], SimClock::getInstance().getHour(time));
 }
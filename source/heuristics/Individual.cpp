@@ -6,10 +6,13 @@
 
 /* external libraries */
 #include <iomanip>
+#include <algorithm>
 #include <numeric>
 #include <iostream>
+#include <cmath>
 /* internal libraries */
 #include "heuristics/Individual.hpp"
+#include "heuristics/ObjectiveAccumulator.hpp"
 #include "Utils.hpp"
 #include "simulator/AmbulanceAllocator.hpp"
 #include "simulator/Simulator.hpp"
@@ -23,7 +26,7 @@ Individual::Individual(
     const bool isChild,
     const bool dayShift,
     const std::vector<GenotypeInitType>& genotypeInits,
-    const std::vector<double>& genotypeInitsTickets
+    const WeightedSampler& genotypeInitsSampler
 ) : rnd(rnd),
     numAmbulances(numAmbulances),
     numAllocations(numAllocations),
@@ -39,14 +42,14 @@ Individual::Individual(
     allocationsObjectivePercentageViolationsRural(numAllocations, 0.0),
     allocationsFitness(numAllocations, 0.0) {
     // init genotype
-    generateGenotype(isChild, dayShift, genotypeInits, genotypeInitsTickets);
+    generateGenotype(isChild, dayShift, genotypeInits, genotypeInitsSampler);
 }
 
 void Individual::generateGenotype(
     const bool isChild,
     const bool dayShift,
     const std::vector<GenotypeInitType>& inits,
-    const std::vector<double>& tickets
+    const WeightedSampler& genotypeInitsSampler
 ) {
     // reset genotype
     emptyGenotype();
@@ -57,7 +60,7 @@ void Individual::generateGenotype(
     }
 
     // get random init from tickets (defined in settings.txt)
-    switch (inits[weightedLottery(rnd, tickets, {})]) {
+    switch (inits[genotypeInitsSampler.sample(rnd)]) {
         case GenotypeInitType::RANDOM:
             randomGenotype();
             break;
@@ -136,6 +139,8 @@ void Individual::proportionateGenotype(const std::string& column, const bool day
         weights[depotIndex] = static_cast<double>(Stations::getInstance().get<int>(column, depotIndices[depotIndex]));
     }
 
+    const WeightedSampler depotSampler(weights);
+
     for (int allocationIndex = 0; allocationIndex < numAllocations; allocationIndex++) {
         int numAmbulancesToAdd = numAmbulances;
 
@@ -148,63 +153,333 @@ void Individual::proportionateGenotype(const std::string& column, const bool day
 
         // randomly distribute the rest of the ambulances based on weights
         for (int ambulanceIndex = 0; ambulanceIndex < numAmbulancesToAdd; ambulanceIndex++) {
-            int depotIndex = weightedLottery(rnd, weights, {});
+            int depotIndex = depotSampler.sample(rnd);
 
             genotype[allocationIndex][depotIndex]++;
         }
     }
 }
 
-void Individual::evaluate(std::vector<Event> events, const bool dayShift, const DispatchEngineStrategyType dispatchStrategy) {
-    // allocate ambulances based on genotype
-    AmbulanceAllocator ambulanceAllocator;
-    ambulanceAllocator.allocate(events, genotype, dayShift);
+void Individual::evaluate(const std::vector<Event>& events, Simulator& simulator) {
+    // run simulator with allocation based on genotype and unprocessed events
+    simulator.reset(events, genotype);
 
-    // run simulator with allocation and unprocessed events
-    Simulator simulator(
-        ambulanceAllocator,
-        dispatchStrategy,
-        events
-    );
+    checkpoint = nullptr;
+    simulator.run(&checkpoint);
+    simulator.swapResults(simulatedEvents, simulatedAmbulances);
+    numScenariosEvaluated = 1;
 
-    simulatedEvents = simulator.run();
-    simulatedAmbulances = ambulanceAllocator.ambulances;
+    updateObjectives();
+}
 
-    // sort simulated/processed events
-    std::sort(simulatedEvents.begin(), simulatedEvents.end(), [](const Event& a, const Event& b) {
-        std::tm aTimeStruct = a.callReceived;
-        std::tm bTimeStruct = b.callReceived;
+void Individual::evaluate(const std::vector<Event>& events, Simulator& simulator, const std::vector<Individual>& parents) {
+    // find the parent sharing the most leading time segments with this genotype
+    const Individual* resumeParent = nullptr;
+    int resumeAllocationIndex = 0;
+    for (const Individual& parent : parents) {
+        int allocationIndex = getResumeAllocationIndex(parent);
 
-        time_t aTime = std::mktime(&aTimeStruct);
-        time_t bTime = std::mktime(&bTimeStruct);
+        if (allocationIndex > resumeAllocationIndex) {
+            resumeParent = &parent;
+            resumeAllocationIndex = allocationIndex;
+        }
+    }
 
-        return aTime < bTime;
-    });
+    // simulate from the start if no time segment can be reused
+    if (resumeParent == nullptr) {
+        evaluate(events, simulator);
+
+        return;
+    }
+
+    evaluate(events, simulator, *resumeParent);
+}
+
+void Individual::evaluate(const std::vector<Event>& events, Simulator& simulator, const Individual& parent) {
+    const int resumeAllocationIndex = getResumeAllocationIndex(parent);
 
-    // update objectives
-    objectiveAvgResponseTimeUrbanA = averageResponseTime(simulatedEvents, "A", true);
-    objectiveAvgResponseTimeUrbanH = averageResponseTime(simulatedEvents, "H", true);
-    objectiveAvgResponseTimeUrbanV1 = averageResponseTime(simulatedEvents, "V1", true);
-    objectiveAvgResponseTimeRuralA = averageResponseTime(simulatedEvents, "A", false);
-    objectiveAvgResponseTimeRuralH = averageResponseTime(simulatedEvents, "H", false);
-    objectiveAvgResponseTimeRuralV1 = averageResponseTime(simulatedEvents, "V1", false);
-    objectivePercentageViolations = responseTimeViolations(simulatedEvents);
-    objectivePercentageViolationsUrban = responseTimeViolationsUrban(simulatedEvents, true);
-    objectivePercentageViolationsRural = responseTimeViolationsUrban(simulatedEvents, false);
-
-    // update objectives per allocation
+    // simulate from the start if no time segment can be reused
+    if (resumeAllocationIndex == 0) {
+        evaluate(events, simulator);
+
+        return;
+    }
+
+    // the shared time segments are simulated exactly as for the parent, so its checkpoints are reused
+    checkpoint = parent.getCheckpoint(resumeAllocationIndex);
+
+    simulator.resume(*checkpoint, genotype);
+
+    simulator.run(&checkpoint);
+    simulator.swapResults(simulatedEvents, simulatedAmbulances);
+    numScenariosEvaluated = 1;
+
+    updateObjectives();
+}
+
+void Individual::evaluateScenarios(
+    const std::vector<std::vector<Event>>& scenarios,
+    std::vector<Simulator>& simulators,
+    ThreadPool& threadPool,
+    const double fitnessThreshold,
+    const double stoppingZScore
+) {
+    if (scenarios.empty()) {
+        return;
+    }
+
+    // samples are kept per calling thread and never shrunk, so their objective vectors are reused between evaluations.
+    // the tasks below run on other threads and reach the buffer through this reference
+    static thread_local std::vector<ScenarioObjectives> sampleBuffer;
+    std::vector<ScenarioObjectives>& samples = sampleBuffer;
+    size_t numSamples = 0;
+    if (samples.size() < 1 + scenarios.size()) {
+        samples.resize(1 + scenarios.size());
+    }
+
+    // objectives of the base scenario from evaluate are the first sample
+    getObjectives(samples[numSamples++]);
+
+    // the stopping test only runs between batches, so with a threshold the first batch is small and later batches
+    // double up to one scenario per simulator
+    const size_t firstBatchSize = 2;
+    size_t maxBatchSize = std::isnan(fitnessThreshold) ? simulators.size() : std::min(firstBatchSize, simulators.size());
+
+    size_t scenarioIndex = 0;
+    while (scenarioIndex < scenarios.size()) {
+        // simulate a batch of scenarios in parallel, each task owns a simulator
+        const size_t batchSize = std::min(maxBatchSize, scenarios.size() - scenarioIndex);
+        const size_t batchStart = numSamples;
+        numSamples += batchSize;
+
+        threadPool.run(batchSize, [&](const size_t batchIndex) {
+            simulateScenario(scenarios[scenarioIndex + batchIndex], simulators[batchIndex], samples[batchStart + batchIndex]);
+        });
+
+        scenarioIndex += batchSize;
+        maxBatchSize = std::min(maxBatchSize * 2, simulators.size());
+
+        // keep all scenarios if there is nothing to compare against
+        if (std::isnan(fitnessThreshold)) {
+            continue;
+        }
+
+        // stop adding scenarios once the mean fitness is clearly better or worse than the threshold
+        const double n = static_cast<double>(numSamples);
+        double mean = 0.0;
+        for (size_t sampleIndex = 0; sampleIndex < numSamples; sampleIndex++) {
+            mean += samples[sampleIndex].fitness;
+        }
+        mean /= n;
+
+        double variance = 0.0;
+        for (size_t sampleIndex = 0; sampleIndex < numSamples; sampleIndex++) {
+            variance += (samples[sampleIndex].fitness - mean) * (samples[sampleIndex].fitness - mean);
+        }
+        variance /= n - 1.0;
+
+        const double standardError = std::sqrt(variance / n);
+        if (std::abs(mean - fitnessThreshold) > stoppingZScore * standardError) {
+            break;
+        }
+    }
+
+    averageObjectives(samples, numSamples);
+}
+
+void Individual::simulateScenario(const std::vector<Event>& events, Simulator& simulator, ScenarioObjectives& sample) const {
+    // only objectives are needed from additional scenarios, so no checkpoints are saved and events aren't kept
+    simulator.reset(events, genotype);
+
+    // kept per thread so its bins are reused, scenarios run on the thread pool workers
+    static thread_local ObjectiveAccumulator accumulator;
+    accumulator.reset(numAllocations);
+    accumulator.accumulate(simulator.run());
+
+    readObjectives(accumulator, sample);
+}
+
+void Individual::averageObjectives(const std::vector<ScenarioObjectives>& samples, const size_t numSamples) {
+    const double n = static_cast<double>(numSamples);
+
+    // simulated events and ambulances are kept from the base scenario
+    static thread_local ScenarioObjectives mean;
+    mean.objectives.fill(0.0);
+    mean.allocationsObjectives.assign(numAllocations, mean.objectives);
+
+    for (size_t sampleIndex = 0; sampleIndex < numSamples; sampleIndex++) {
+        const ScenarioObjectives& sample = samples[sampleIndex];
+
+        for (size_t objectiveIndex = 0; objectiveIndex < NUM_OBJECTIVE_TYPES; objectiveIndex++) {
+            mean.objectives[objectiveIndex] += sample.objectives[objectiveIndex] / n;
+        }
+
+        for (int allocationIndex = 0; allocationIndex < numAllocations; allocationIndex++) {
+            for (size_t objectiveIndex = 0; objectiveIndex < NUM_OBJECTIVE_TYPES; objectiveIndex++) {
+                mean.allocationsObjectives[allocationIndex][objectiveIndex] +=
+                    sample.allocationsObjectives[allocationIndex][objectiveIndex] / n;
+            }
+        }
+    }
+
+    setObjectives(mean);
+    numScenariosEvaluated = static_cast<int>(numSamples);
+
+    updateMetrics();
+}
+
+void Individual::readObjectives(const ObjectiveAccumulator& accumulator, ScenarioObjectives& values) const {
+    values.allocationsObjectives.resize(numAllocations);
+
+    // allocation index -1 reads the objectives of the whole shift
+    for (int allocationIndex = -1; allocationIndex < numAllocations; allocationIndex++) {
+        std::array<double, NUM_OBJECTIVE_TYPES>& objectives = allocationIndex == -1
+            ? values.objectives
+            : values.allocationsObjectives[allocationIndex];
+
+        objectives = {
+            accumulator.averageResponseTime("A", true, allocationIndex),
+            accumulator.averageResponseTime("H", true, allocationIndex),
+            accumulator.averageResponseTime("V1", true, allocationIndex),
+            accumulator.averageResponseTime("A", false, allocationIndex),
+            accumulator.averageResponseTime("H", false, allocationIndex),
+            accumulator.averageResponseTime("V1", false, allocationIndex),
+            accumulator.responseTimeViolations(allocationIndex),
+            accumulator.responseTimeViolationsUrban(true, allocationIndex),
+            accumulator.responseTimeViolationsUrban(false, allocationIndex)
+        };
+    }
+
+    values.fitness = getWeightedFitness(values.objectives);
+}
+
+void Individual::getObjectives(ScenarioObjectives& values) const {
+    values.fitness = fitness;
+    values.objectives = {
+        objectiveAvgResponseTimeUrbanA,
+        objectiveAvgResponseTimeUrbanH,
+        objectiveAvgResponseTimeUrbanV1,
+        objectiveAvgResponseTimeRuralA,
+        objectiveAvgResponseTimeRuralH,
+        objectiveAvgResponseTimeRuralV1,
+        objectivePercentageViolations,
+        objectivePercentageViolationsUrban,
+        objectivePercentageViolationsRural
+    };
+
+    values.allocationsObjectives.resize(numAllocations);
     for (int allocationIndex = 0; allocationIndex < numAllocations; allocationIndex++) {
-        allocationsObjectiveAvgResponseTimeUrbanA[allocationIndex] = averageResponseTime(simulatedEvents, "A", true, allocationIndex);
-        allocationsObjectiveAvgResponseTimeUrbanH[allocationIndex] = averageResponseTime(simulatedEvents, "H", true, allocationIndex);
-        allocationsObjectiveAvgResponseTimeUrbanV1[allocationIndex] = averageResponseTime(simulatedEvents, "V1", true, allocationIndex);
-        allocationsObjectiveAvgResponseTimeRuralA[allocationIndex] = averageResponseTime(simulatedEvents, "A", false, allocationIndex);
-        allocationsObjectiveAvgResponseTimeRuralH[allocationIndex] = averageResponseTime(simulatedEvents, "H", false, allocationIndex);
-        allocationsObjectiveAvgResponseTimeRuralV1[allocationIndex] = averageResponseTime(simulatedEvents, "V1", false, allocationIndex);
-        allocationsObjectivePercentageViolations[allocationIndex] = responseTimeViolations(simulatedEvents, allocationIndex);
-        allocationsObjectivePercentageViolationsUrban[allocationIndex] = responseTimeViolationsUrban(simulatedEvents, true, allocationIndex);
-        allocationsObjectivePercentageViolationsRural[allocationIndex] = responseTimeViolationsUrban(simulatedEvents, false, allocationIndex);
+        values.allocationsObjectives[allocationIndex] = {
+            allocationsObjectiveAvgResponseTimeUrbanA[allocationIndex],
+            allocationsObjectiveAvgResponseTimeUrbanH[allocationIndex],
+            allocationsObjectiveAvgResponseTimeUrbanV1[allocationIndex],
+            allocationsObjectiveAvgResponseTimeRuralA[allocationIndex],
+            allocationsObjectiveAvgResponseTimeRuralH[allocationIndex],
+            allocationsObjectiveAvgResponseTimeRuralV1[allocationIndex],
+            allocationsObjectivePercentageViolations[allocationIndex],
+            allocationsObjectivePercentageViolationsUrban[allocationIndex],
+            allocationsObjectivePercentageViolationsRural[allocationIndex]
+        };
+    }
+}
+
+void Individual::setObjectives(const ScenarioObjectives& values) {
+    objectiveAvgResponseTimeUrbanA = values.objectives[0];
+    objectiveAvgResponseTimeUrbanH = values.objectives[1];
+    objectiveAvgResponseTimeUrbanV1 = values.objectives[2];
+    objectiveAvgResponseTimeRuralA = values.objectives[3];
+    objectiveAvgResponseTimeRuralH = values.objectives[4];
+    objectiveAvgResponseTimeRuralV1 = values.objectives[5];
+    objectivePercentageViolations = values.objectives[6];
+    objectivePercentageViolationsUrban = values.objectives[7];
+    objectivePercentageViolationsRural = values.objectives[8];
+
+    for (int allocationIndex = 0; allocationIndex < numAllocations; allocationIndex++) {
+        const std::array<double, NUM_OBJECTIVE_TYPES>& objectives = values.allocationsObjectives[allocationIndex];
+
+        allocationsObjectiveAvgResponseTimeUrbanA[allocationIndex] = objectives[0];
+        allocationsObjectiveAvgResponseTimeUrbanH[allocationIndex] = objectives[1];
+        allocationsObjectiveAvgResponseTimeUrbanV1[allocationIndex] = objectives[2];
+        allocationsObjectiveAvgResponseTimeRuralA[allocationIndex] = objectives[3];
+        allocationsObjectiveAvgResponseTimeRuralH[allocationIndex] = objectives[4];
+        allocationsObjectiveAvgResponseTimeRuralV1[allocationIndex] = objectives[5];
+        allocationsObjectivePercentageViolations[allocationIndex] = objectives[6];
+        allocationsObjectivePercentageViolationsUrban[allocationIndex] = objectives[7];
+        allocationsObjectivePercentageViolationsRural[allocationIndex] = objectives[8];
+    }
+}
+
+double Individual::getWeightedFitness(const std::array<double, NUM_OBJECTIVE_TYPES>& values) const {
+    // same weights and order as the fitness in updateMetrics
+    const std::array<double, NUM_OBJECTIVE_TYPES> weights = {
+        weightAvgResponseTimeUrbanA,
+        weightAvgResponseTimeUrbanH,
+        weightAvgResponseTimeUrbanV1,
+        weightAvgResponseTimeRuralA,
+        weightAvgResponseTimeRuralH,
+        weightAvgResponseTimeRuralV1,
+        weightPercentageViolations,
+        weightPercentageViolationsUrban,
+        weightPercentageViolationsRural
+    };
+
+    double weightedFitness = 0.0;
+    for (size_t objectiveIndex = 0; objectiveIndex < NUM_OBJECTIVE_TYPES; objectiveIndex++) {
+        weightedFitness += values[objectiveIndex] * weights[objectiveIndex];
+    }
+
+    return weightedFitness;
+}
+
+std::shared_ptr<const SimulationCheckpoint> Individual::getCheckpoint(const int allocationIndex) const {
+    // walk back from the last checkpoint
+    std::shared_ptr<const SimulationCheckpoint> link = checkpoint;
+    while (link != nullptr && link->allocationIndex > allocationIndex) {
+        link = link->previous;
+    }
+
+    if (link == nullptr || link->allocationIndex != allocationIndex) {
+        return nullptr;
+    }
+
+    return link;
+}
+
+int Individual::getResumeAllocationIndex(const Individual& parent) const {
+    if (parent.checkpoint == nullptr || parent.numAllocations != numAllocations) {
+        return 0;
     }
 
+    int sharedAllocations = 0;
+    while (sharedAllocations < numAllocations && parent.genotype[sharedAllocations] == genotype[sharedAllocations]) {
+        sharedAllocations++;
+    }
+
+    // resume from first changed time segment, or the last one if the genotype is unchanged
+    int allocationIndex = std::min(sharedAllocations, numAllocations - 1);
+    if (parent.getCheckpoint(allocationIndex) == nullptr) {
+        return 0;
+    }
+
+    return allocationIndex;
+}
+
+void Individual::updateObjectives() {
+    // sort simulated/processed events
+    std::sort(simulatedEvents.begin(), simulatedEvents.end(), [](const Event& a, const Event& b) {
+        return a.callReceived < b.callReceived;
+    });
+
+    // bin events in one pass, all objectives are read from the bins. both are kept per thread so they are reused
+    static thread_local ObjectiveAccumulator accumulator;
+    static thread_local ScenarioObjectives values;
+    accumulator.reset(numAllocations);
+    accumulator.accumulate(simulatedEvents);
+
+    // update objectives, in total and per allocation
+    readObjectives(accumulator, values);
+    setObjectives(values);
+
     // update metrics (fitness, rank, etc.)
     updateMetrics();
 }
@@ -275,10 +550,10 @@ void Individual::updateMetrics() {
 void Individual::mutate(
     const double mutationProbability,
     const std::vector<MutationType>& mutations,
-    const std::vector<double>& tickets
+    const WeightedSampler& mutationsSampler
 ) {
     // do random mutation from tickets (defined in settings.txt)
-    switch (mutations[weightedLottery(rnd, tickets, {})]) {
+    switch (mutations[mutationsSampler.sample(rnd)]) {
         case MutationType::REDISTRIBUTE:
             redistributeMutation(mutationProbability);
             break;
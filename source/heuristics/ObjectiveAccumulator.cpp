@@ -0,0 +1,136 @@
+/**
+ * @file ObjectiveAccumulator.cpp
+ *
+ * @copyright Copyright (c) 2024 Emergency-Optimizers
+ */
+
+/* internal libraries */
+#include "heuristics/ObjectiveAccumulator.hpp"
+
+void ObjectiveAccumulator::reset(const int newNumAllocations) {
+    numAllocations = newNumAllocations;
+
+    bins.assign((numAllocations + 1) * NUM_TRIAGES * 2, Bin());
+}
+
+int ObjectiveAccumulator::getTriageIndex(const std::string& triageImpression) {
+    if (triageImpression == "A") {
+        return 0;
+    } else if (triageImpression == "H") {
+        return 1;
+    } else if (triageImpression == "V1") {
+        return TRIAGE_V1;
+    }
+
+    return 3;
+}
+
+int ObjectiveAccumulator::getBinIndex(const int segmentSlot, const int triageIndex, const bool urban) const {
+    return (segmentSlot * NUM_TRIAGES + triageIndex) * 2 + static_cast<int>(urban);
+}
+
+void ObjectiveAccumulator::accumulate(const std::vector<Event>& simulatedEvents) {
+    for (const Event& event : simulatedEvents) {
+        accumulate(event);
+    }
+}
+
+void ObjectiveAccumulator::accumulate(const Event& event) {
+    const int urbanAcuteResponseTimeGoalSeconds = 720;
+    const int ruralAcuteResponseTimeGoalSeconds = 1500;
+    const int urbanUrgentResponseTimeGoalSeconds = 1800;
+    const int ruralUrgentResponseTimeGoalSeconds = 2400;
+
+    // skip utility events (warmp-up, reallocation)
+    if (event.utility) {
+        return;
+    }
+
+    const bool validAllocation = event.allocationIndex >= 0 && event.allocationIndex < numAllocations;
+    const int segmentSlot = validAllocation ? event.allocationIndex + 1 : 0;
+    const int triageIndex = getTriageIndex(event.triageImpression);
+    const bool urban = event.urban;
+
+    const int responseTime = event.getResponseTime();
+
+    Bin& bin = bins[getBinIndex(segmentSlot, triageIndex, urban)];
+    bin.totalResponseTime += responseTime;
+    bin.totalEvents++;
+
+    // check if response time violates the guidelines
+    if (triageIndex == 0) {
+        bin.totalViolations += responseTime > (urban ? urbanAcuteResponseTimeGoalSeconds : ruralAcuteResponseTimeGoalSeconds);
+    } else if (triageIndex == 1) {
+        bin.totalViolations += responseTime > (urban ? urbanUrgentResponseTimeGoalSeconds : ruralUrgentResponseTimeGoalSeconds);
+    }
+}
+
+ObjectiveAccumulator::Bin ObjectiveAccumulator::sumBins(const int allocationIndex, const int triageIndex, const bool urban) const {
+    // sum over all segment slots if no allocation is specified
+    const int firstSlot = allocationIndex == -1 ? 0 : allocationIndex + 1;
+    const int lastSlot = allocationIndex == -1 ? numAllocations : allocationIndex + 1;
+
+    Bin sum;
+    for (int segmentSlot = firstSlot; segmentSlot <= lastSlot; segmentSlot++) {
+        const Bin& bin = bins[getBinIndex(segmentSlot, triageIndex, urban)];
+
+        sum.totalResponseTime += bin.totalResponseTime;
+        sum.totalEvents += bin.totalEvents;
+        sum.totalViolations += bin.totalViolations;
+    }
+
+    return sum;
+}
+
+double ObjectiveAccumulator::averageResponseTime(
+    const std::string& triageImpression,
+    const bool urban,
+    const int allocationIndex
+) const {
+    const Bin sum = sumBins(allocationIndex, getTriageIndex(triageImpression), urban);
+
+    if (sum.totalEvents == 0) {
+        return 0;
+    }
+
+    // calculate mean response time (MRT)
+    return static_cast<double>(sum.totalResponseTime) / static_cast<double>(sum.totalEvents);
+}
+
+double ObjectiveAccumulator::violations(const int allocationIndex, const bool countUrban, const bool countRural) const {
+    double totalEvents = 0.0;
+    double totalViolations = 0.0;
+
+    // V1 incidents have no response time goal and are left out
+    for (const bool urban : {true, false}) {
+        if (urban ? !countUrban : !countRural) {
+            continue;
+        }
+
+        for (int triageIndex = 0; triageIndex < NUM_TRIAGES; triageIndex++) {
+            if (triageIndex == TRIAGE_V1) {
+                continue;
+            }
+
+            const Bin sum = sumBins(allocationIndex, triageIndex, urban);
+
+            totalEvents += sum.totalEvents;
+            totalViolations += sum.totalViolations;
+        }
+    }
+
+    if (totalEvents == 0.0) {
+        return 0.0;
+    }
+
+    // returns percentage of incidents that violated guidelines
+    return totalViolations / totalEvents;
+}
+
+double ObjectiveAccumulator::responseTimeViolations(const int allocationIndex) const {
+    return violations(allocationIndex, true, true);
+}
+
+double ObjectiveAccumulator::responseTimeViolationsUrban(const bool checkUrban, const int allocationIndex) const {
+    return violations(allocationIndex, checkUrban, !checkUrban);
+}
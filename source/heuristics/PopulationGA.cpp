@@ -10,13 +10,18 @@
 #include <string>
 #include <iostream>
 #include <set>
+#include <limits>
+#include <algorithm>
 /* internal libraries */
 #include "ProgressBar.hpp"
 #include "heuristics/PopulationGA.hpp"
 #include "Utils.hpp"
 #include "simulator/MonteCarloSimulator.hpp"
 
-PopulationGA::PopulationGA(const std::vector<Event>& events) : events(events) {
+PopulationGA::PopulationGA(
+    const std::vector<Event>& events,
+    const std::vector<std::vector<Event>>& scenarios
+) : events(events), scenarios(scenarios) {
     // generate list of possible genotype inits, mutations, crossovers (defined in settings.txt)
     getPossibleGenotypeInits();
     getPossibleMutations();
@@ -31,10 +36,14 @@ PopulationGA::PopulationGA(const std::vector<Event>& events) : events(events) {
 void PopulationGA::generatePopulation() {
     individuals.clear();
 
+    // initial population has nothing to compare against, so all scenarios are used
+    const double fitnessThreshold = std::numeric_limits<double>::quiet_NaN();
+
     const bool isChild = false;
     for (int i = 0; i < populationSize; i++) {
         Individual newIndividual = createIndividual(isChild);
-        newIndividual.evaluate(events, dayShift, dispatchStrategy);
+        newIndividual.evaluate(events, simulator);
+        newIndividual.evaluateScenarios(scenarios, scenarioSimulators, scenarioThreadPool, fitnessThreshold, scenarioStoppingZScore);
 
         individuals.push_back(newIndividual);
     }
@@ -91,6 +100,19 @@ void PopulationGA::evolve(const bool verbose, std::string extraFileName) {
     writeEvents(dirName, finalIndividual.simulatedEvents, "events" + extraFileName);
     writeGenotype(dirName, finalIndividual.genotype, "genotype" + extraFileName);
     writeAmbulances(dirName, finalIndividual.simulatedAmbulances, "ambulances" + extraFileName);
+    writeStats(dirName, "stats" + extraFileName);
+
+    // simulate the final individual again to get its trace
+    if (simulator.traceRecorder.isEnabled()) {
+        simulator.reset(events, finalIndividual.genotype);
+        simulator.run();
+
+        simulator.traceRecorder.write(dirName, "trace" + extraFileName);
+        TraceRecorder::decode(
+            "../data/" + dirName + "/trace" + extraFileName + ".bin",
+            "../data/" + dirName + "/trace" + extraFileName + ".csv"
+        );
+    }
 
     // print metrics to terminal
     if (verbose) {
@@ -130,9 +152,9 @@ void PopulationGA::evolve(const bool verbose, std::string extraFileName) {
 void PopulationGA::getPossibleGenotypeInits() {
     // clear lists
     genotypeInits.clear();
-    genotypeInitsTickets.clear();
 
-    // add types and tickets if applicable
+    // add types and tickets if applicable, tickets are only needed to build the sampler
+    std::vector<double> genotypeInitsTickets;
     double tickets;
 
     tickets = Settings::get<double>("GENOTYPE_INIT_TICKETS_RANDOM");
@@ -187,14 +209,16 @@ void PopulationGA::getPossibleGenotypeInits() {
     if (genotypeInits.empty()) {
         throwError("No applicable genotype inits.");
     }
+
+    genotypeInitsSampler = WeightedSampler(genotypeInitsTickets);
 }
 
 void PopulationGA::getPossibleMutations() {
     // clear lists
     mutations.clear();
-    mutationsTickets.clear();
 
-    // add types and tickets if applicable
+    // add types and tickets if applicable, tickets are only needed to build the sampler
+    std::vector<double> mutationsTickets;
     double tickets;
 
     tickets = Settings::get<double>("MUTATION_TICKETS_REDISTRIBUTE");
@@ -225,14 +249,16 @@ void PopulationGA::getPossibleMutations() {
     if (mutations.empty()) {
         throwError("No applicable mutations.");
     }
+
+    mutationsSampler = WeightedSampler(mutationsTickets);
 }
 
 void PopulationGA::getPossibleCrossovers() {
     // clear lists
     crossovers.clear();
-    crossoversTickets.clear();
 
-    // add types and tickets if applicable
+    // add types and tickets if applicable, tickets are only needed to build the sampler
+    std::vector<double> crossoversTickets;
     double tickets;
 
     tickets = Settings::get<double>("CROSSOVER_TICKETS_SINGLE_POINT");
@@ -263,14 +289,16 @@ void PopulationGA::getPossibleCrossovers() {
     if (crossovers.empty()) {
         throwError("No applicable crossovers.");
     }
+
+    crossoversSampler = WeightedSampler(crossoversTickets);
 }
 
 void PopulationGA::getPossibleParentSelections() {
     // clear lists
     parentSelections.clear();
-    parentSelectionsTickets.clear();
 
-    // add types and tickets if applicable
+    // add types and tickets if applicable, tickets are only needed to build the sampler
+    std::vector<double> parentSelectionsTickets;
     double tickets;
 
     tickets = Settings::get<double>("PARENT_SELECTION_TICKETS_TOURNAMENT");
@@ -301,14 +329,16 @@ void PopulationGA::getPossibleParentSelections() {
     if (parentSelections.empty()) {
         throwError("No applicable parent selections.");
     }
+
+    parentSelectionsSampler = WeightedSampler(parentSelectionsTickets);
 }
 
 void PopulationGA::getPossibleSurvivorSelections() {
     // clear lists
     survivorSelections.clear();
-    survivorSelectionsTickets.clear();
 
-    // add types and tickets if applicable
+    // add types and tickets if applicable, tickets are only needed to build the sampler
+    std::vector<double> survivorSelectionsTickets;
     double tickets;
 
     tickets = Settings::get<double>("SURVIVOR_SELECTION_TICKETS_TOURNAMENT");
@@ -339,6 +369,8 @@ void PopulationGA::getPossibleSurvivorSelections() {
     if (survivorSelections.empty()) {
         throwError("No applicable survivor selections.");
     }
+
+    survivorSelectionsSampler = WeightedSampler(survivorSelectionsTickets);
 }
 
 std::vector<Individual> PopulationGA::createOffspring() {
@@ -347,12 +379,16 @@ std::vector<Individual> PopulationGA::createOffspring() {
     while (offspring.size() < populationSize) {
         std::vector<Individual> parents = parentSelection();
 
+        // offspring only need enough scenarios to tell if they would survive among the population and earlier offspring
+        const double fitnessThreshold = getScenarioFitnessThreshold(offspring);
+
         if (getRandomDouble(rnd) < crossoverProbability) {
             // generate children from crossover (mutation happens in the crossover function)
             std::vector<Individual> children = crossover(parents[0], parents[1]);
 
             for (auto& child : children) {
-                child.evaluate(events, dayShift, dispatchStrategy);
+                child.evaluate(events, simulator, parents);
+                child.evaluateScenarios(scenarios, scenarioSimulators, scenarioThreadPool, fitnessThreshold, scenarioStoppingZScore);
                 offspring.push_back(child);
             }
         } else {
@@ -363,8 +399,9 @@ std::vector<Individual> PopulationGA::createOffspring() {
             clonedOffspring.genotype = getRandomBool(rnd) ? parents[0].genotype : parents[1].genotype;
 
             // apply mutation to the cloned offspring
-            clonedOffspring.mutate(mutationProbability, mutations, mutationsTickets);
-            clonedOffspring.evaluate(events, dayShift, dispatchStrategy);
+            clonedOffspring.mutate(mutationProbability, mutations, mutationsSampler);
+            clonedOffspring.evaluate(events, simulator, parents);
+            clonedOffspring.evaluateScenarios(scenarios, scenarioSimulators, scenarioThreadPool, fitnessThreshold, scenarioStoppingZScore);
 
             offspring.push_back(clonedOffspring);
         }
@@ -383,7 +420,7 @@ std::vector<Individual> PopulationGA::parentSelection() {
     std::vector<int> selectedIndices;
 
     // perform parent selection based on tickets (defined in settings.txt)
-    switch(parentSelections[weightedLottery(rnd, parentSelectionsTickets, {})]) {
+    switch(parentSelections[parentSelectionsSampler.sample(rnd)]) {
         case SelectionType::TOURNAMENT:
             selectedIndices = tournamentSelection(
                 populationIndices,
@@ -433,7 +470,7 @@ std::vector<Individual> PopulationGA::survivorSelection() {
     std::vector<int> selectedIndices;
 
     // perform survivor selection based on tickets (defined in settings.txt)
-    switch(survivorSelections[weightedLottery(rnd, survivorSelectionsTickets, {})]) {
+    switch(survivorSelections[survivorSelectionsSampler.sample(rnd)]) {
         case SelectionType::TOURNAMENT:
             selectedIndices = tournamentSelection(
                 populationIndices,
@@ -598,7 +635,7 @@ std::vector<Individual> PopulationGA::crossover(const Individual& parent1, const
     std::vector<std::vector<std::vector<int>>> offspringGenotypes;
 
     // generate genotypes from crossover based on tickets (defined in settings.txt)
-    switch(crossovers[weightedLottery(rnd, crossoversTickets, {})]) {
+    switch(crossovers[crossoversSampler.sample(rnd)]) {
         case CrossoverType::SINGLE_POINT:
             offspringGenotypes = singlePointCrossover(parent1.genotype, parent2.genotype);
             break;
@@ -626,7 +663,7 @@ std::vector<Individual> PopulationGA::crossover(const Individual& parent1, const
         child.genotype = offspringGenotypes[i];
 
         child.repair();
-        child.mutate(mutationProbability, mutations, mutationsTickets);
+        child.mutate(mutationProbability, mutations, mutationsSampler);
 
         offspring.push_back(child);
     }
@@ -748,7 +785,7 @@ Individual PopulationGA::createIndividual(const bool child) {
         child,
         dayShift,
         genotypeInits,
-        genotypeInitsTickets
+        genotypeInitsSampler
     );
 
     return individual;
@@ -845,6 +882,42 @@ int PopulationGA::countUnique() const {
     return static_cast<int>(uniqueGenotypes.size());
 }
 
+double PopulationGA::getScenarioFitnessThreshold(const std::vector<Individual>& offspring) const {
+    if (individuals.empty()) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+
+    // fitness of the worst individual that would survive if the population size best of the parents and the
+    // offspring created so far were kept
+    std::vector<double> fitnesses;
+    fitnesses.reserve(individuals.size() + offspring.size());
+    for (const Individual& individual : individuals) {
+        fitnesses.push_back(individual.fitness);
+    }
+    for (const Individual& individual : offspring) {
+        fitnesses.push_back(individual.fitness);
+    }
+
+    const size_t survivorIndex = std::min(static_cast<size_t>(populationSize), fitnesses.size()) - 1;
+    std::nth_element(fitnesses.begin(), fitnesses.begin() + survivorIndex, fitnesses.end());
+
+    return fitnesses[survivorIndex];
+}
+
+void PopulationGA::writeStats(const std::string& dirName, const std::string& fileName) const {
+    if (!config.collectStats) {
+        return;
+    }
+
+    // sum the stats of the main simulator and the per thread scenario simulators
+    SimulationStats stats = simulator.stats;
+    for (const Simulator& scenarioSimulator : scenarioSimulators) {
+        stats.merge(scenarioSimulator.stats);
+    }
+
+    saveDataToJson(dirName, fileName, stats.toDataMap());
+}
+
 bool PopulationGA::shouldStop() {
     // stopping criteria defined in settings.txt
     bool stoppingCriteria = false;
@@ -17,7 +17,10 @@
 #include "file-reader/Settings.hpp"
 #include "Utils.hpp"
 
-PopulationMA::PopulationMA(const std::vector<Event>& events) : PopulationGA(events) { }
+PopulationMA::PopulationMA(
+    const std::vector<Event>& events,
+    const std::vector<std::vector<Event>>& scenarios
+) : PopulationGA(events, scenarios) { }
 
 std::vector<Individual> PopulationMA::createOffspring() {
     std::vector<Individual> offspring = PopulationGA::createOffspring();
@@ -53,15 +56,17 @@ void PopulationMA::localSearch(Individual& individual) {
     const int allocationIndex = getRandomInt(rnd, 0, numTimeSegments - 1);
 
     // find the worst performing depot in the allocation
+    const std::vector<double> depotPerformances = responseTimeViolationsPerDepot(
+        individual.simulatedEvents,
+        allocationIndex,
+        numDepots
+    );
+
     int worstPerformingDepotIndex = -1;
     double worstPerformanceDepot = std::numeric_limits<double>::min();
 
     for (int depotIndex = 0; depotIndex < numDepots; depotIndex++) {
-        double depotPerformance = responseTimeViolations(
-            individual.simulatedEvents,
-            allocationIndex,
-            depotIndex
-        );
+        double depotPerformance = depotPerformances[depotIndex];
 
         if (worstPerformingDepotIndex == -1 || depotPerformance > worstPerformanceDepot) {
             worstPerformingDepotIndex = depotIndex;
@@ -69,6 +74,9 @@ void PopulationMA::localSearch(Individual& individual) {
         }
     }
 
+    // candidate is reused for every move, only the time segments from allocation index and onwards are simulated
+    Individual newIndividual = individual;
+
     // try to move an ambulance from each depot to the worst performing depot
     for (int depotIndex = 0; depotIndex < numDepots; depotIndex++) {
         if (individual.genotype[allocationIndex][depotIndex] < 1) {
@@ -79,11 +87,12 @@ void PopulationMA::localSearch(Individual& individual) {
             continue;
         }
 
-        Individual newIndividual = individual;
+        newIndividual.genotype[allocationIndex] = individual.genotype[allocationIndex];
         newIndividual.genotype[allocationIndex][depotIndex]--;
         newIndividual.genotype[allocationIndex][worstPerformingDepotIndex]++;
 
-        newIndividual.evaluate(events, dayShift, dispatchStrategy);
+        newIndividual.evaluate(events, simulator, individual);
+        newIndividual.evaluateScenarios(scenarios, scenarioSimulators, scenarioThreadPool, individual.fitness, scenarioStoppingZScore);
 
         /*std::cout
             << individual.fitness << " (current: " << responseTimeViolations(individual.simulatedEvents, allocationIndex, depotIndex)
@@ -9,10 +9,12 @@
 /* internal libraries */
 #include "heuristics/PopulationMemeticNSGA2.hpp"
 
-PopulationMemeticNSGA2::PopulationMemeticNSGA2(const std::vector<Event>& events) :
-    PopulationGA(events),
-    PopulationNSGA2(events),
-    PopulationMA(events) { }
+PopulationMemeticNSGA2::PopulationMemeticNSGA2(
+    const std::vector<Event>& events,
+    const std::vector<std::vector<Event>>& scenarios
+) : PopulationGA(events, scenarios),
+    PopulationNSGA2(events, scenarios),
+    PopulationMA(events, scenarios) { }
 
 const std::string PopulationMemeticNSGA2::getHeuristicName() const {
     return heuristicName;
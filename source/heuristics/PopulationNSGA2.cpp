@@ -10,6 +10,7 @@
 #include <string>
 #include <iostream>
 #include <set>
+#include <limits>
 /* internal libraries */
 #include "ProgressBar.hpp"
 #include "heuristics/PopulationNSGA2.hpp"
@@ -17,7 +18,10 @@
 #include "Utils.hpp"
 #include "simulator/MonteCarloSimulator.hpp"
 
-PopulationNSGA2::PopulationNSGA2(const std::vector<Event>& events) : PopulationGA(events) { }
+PopulationNSGA2::PopulationNSGA2(
+    const std::vector<Event>& events,
+    const std::vector<std::vector<Event>>& scenarios
+) : PopulationGA(events, scenarios) { }
 
 void PopulationNSGA2::evolve(const bool verbose, std::string extraFileName) {
     // sort and store metrics for initial population
@@ -76,6 +80,7 @@ void PopulationNSGA2::evolve(const bool verbose, std::string extraFileName) {
     // write to file
     const std::string dirName = Settings::get<std::string>("UNIQUE_RUN_ID") + "_" + getHeuristicName();
     saveDataToJson(dirName, "heuristic" + extraFileName, metrics);
+    writeStats(dirName, "stats" + extraFileName);
     for (int i = 0; i < individuals.size(); i++) {
         writeEvents(dirName, finalIndividual.simulatedEvents, "events" + extraFileName + "_ind_" + std::to_string(i));
         writeGenotype(dirName, finalIndividual.genotype, "genotype" + extraFileName + "_ind_" + std::to_string(i));
@@ -340,3 +345,8 @@ void PopulationNSGA2::storeGenerationMetrics() {
 const std::string PopulationNSGA2::getHeuristicName() const {
     return heuristicName;
 }
+
+double PopulationNSGA2::getScenarioFitnessThreshold(const std::vector<Individual>& /*offspring*/) const {
+    // selection is based on fronts and crowding distance, not fitness, so every scenario is used
+    return std::numeric_limits<double>::quiet_NaN();
+}
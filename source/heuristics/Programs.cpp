@@ -13,6 +13,7 @@
 #include <numeric>
 #include <chrono>
 #include <filesystem>
+#include <memory>
 /* internal libraries */
 #include "heuristics/Programs.hpp"
 #include "Utils.hpp"
@@ -27,9 +28,30 @@
 #include "file-reader/Stations.hpp"
 #include "simulator/AmbulanceAllocator.hpp"
 #include "simulator/Simulator.hpp"
+#include "simulator/EventGenerator.hpp"
+#include "simulator/SimClock.hpp"
+#include "heuristics/ObjectiveAccumulator.hpp"
 #include "simulator/strategies/DispatchEngineStrategyType.hpp"
 #include "simulator/MonteCarloSimulator.hpp"
 
+std::vector<std::vector<int>> getSimplifiedOUHAllocations(const bool dayShift) {
+    std::vector<std::vector<int>> allocations;
+    allocations.push_back({2, 3, 2, 2, 2, 4, 2, 3, 3, 4, 4, 4, 4, 3, 3});
+
+    // set rapid response points to 0 if day shift
+    if (dayShift) {
+        int allocationSize = static_cast<int>(allocations.size());
+        for (int allocationIndex = 0; allocationIndex < allocationSize; allocationIndex++) {
+            allocations[allocationIndex].push_back(0);
+            allocations[allocationIndex].push_back(0);
+            allocations[allocationIndex].push_back(0);
+            allocations[allocationIndex].push_back(0);
+        }
+    }
+
+    return allocations;
+}
+
 void runSimulatorOnce(
     std::vector<Event>& events,
     const bool verbose,
@@ -39,35 +61,15 @@ void runSimulatorOnce(
 ) {
     // set allocation to simplified OUH version
     if (allocations.empty()) {
-        allocations.push_back({2, 3, 2, 2, 2, 4, 2, 3, 3, 4, 4, 4, 4, 3, 3});
-
-        // set rapid response points to 0 if day shift
-        if (Settings::get<bool>("SIMULATE_DAY_SHIFT")) {
-            int allocationSize = static_cast<int>(allocations.size());
-            for (int allocationIndex = 0; allocationIndex < allocationSize; allocationIndex++) {
-                allocations[allocationIndex].push_back(0);
-                allocations[allocationIndex].push_back(0);
-                allocations[allocationIndex].push_back(0);
-                allocations[allocationIndex].push_back(0);
-            }
-        }
+        allocations = getSimplifiedOUHAllocations(Settings::get<bool>("SIMULATE_DAY_SHIFT"));
     }
 
-    AmbulanceAllocator ambulanceAllocator;
-    ambulanceAllocator.allocate(
-        events,
-        allocations,
-        Settings::get<bool>("SIMULATE_DAY_SHIFT")
-    );
+    const SimulationConfig config = SimulationConfig::fromSettings();
 
     // simulate events
-    Simulator simulator(
-        ambulanceAllocator,
-        Settings::get<DispatchEngineStrategyType>("DISPATCH_STRATEGY"),
-        events
-    );
-    std::vector<Event> simulatedEvents;
-    simulatedEvents = simulator.run();
+    Simulator simulator(config);
+    simulator.reset(events, allocations);
+    std::vector<Event> simulatedEvents = simulator.run();
 
     if (saveToFile) {
         // write events to file
@@ -75,7 +77,19 @@ void runSimulatorOnce(
 
         writeEvents(dirName, simulatedEvents, "events" + extraFileName);
         writeGenotype(dirName, allocations, "genotype" + extraFileName);
-        writeAmbulances(dirName, ambulanceAllocator.ambulances, "ambulances" + extraFileName);
+        writeAmbulances(dirName, simulator.ambulanceAllocator.ambulances, "ambulances" + extraFileName);
+
+        if (config.collectStats) {
+            saveDataToJson(dirName, "stats" + extraFileName, simulator.stats.toDataMap());
+        }
+
+        if (simulator.traceRecorder.isEnabled()) {
+            simulator.traceRecorder.write(dirName, "trace" + extraFileName);
+            TraceRecorder::decode(
+                "../data/" + dirName + "/trace" + extraFileName + ".bin",
+                "../data/" + dirName + "/trace" + extraFileName + ".csv"
+            );
+        }
     }
 
     if (verbose) {
@@ -87,7 +101,7 @@ void runSimulatorOnce(
         double avgResponseTimeV1Urban = averageResponseTime(simulatedEvents, "V1", true);
         double avgResponseTimeV1Nonurban = averageResponseTime(simulatedEvents, "V1", false);
 
-        printAmbulanceWorkload(ambulanceAllocator.ambulances);
+        printAmbulanceWorkload(simulator.ambulanceAllocator.ambulances);
 
         std::cout
             << "\nGoal:" << std::endl
@@ -108,23 +122,265 @@ void runSimulatorOnce(
     }
 }
 
-void runGeneticAlgorithm(const std::vector<Event>& events) {
-    PopulationGA population(events);
+void runSimulatorStreamed(
+    const MonteCarloSimulator& monteCarloSimulator,
+    const bool verbose,
+    const bool saveToFile,
+    std::vector<std::vector<int>> allocations
+) {
+    // set allocation to simplified OUH version
+    if (allocations.empty()) {
+        allocations = getSimplifiedOUHAllocations(Settings::get<bool>("SIMULATE_DAY_SHIFT"));
+    }
+
+    const SimulationConfig config = SimulationConfig::fromSettings();
+    const std::string dirName = Settings::get<std::string>("UNIQUE_RUN_ID") + "_NONE";
+
+    // finished events are written and accumulated as they leave the event queue instead of being kept until the end
+    std::ofstream eventsFile;
+    if (saveToFile) {
+        createDirectory(dirName);
+        eventsFile.open("../data/" + dirName + "/events.csv");
+        writeEventsHeader(eventsFile);
+    }
+
+    ObjectiveAccumulator objectiveAccumulator;
+    objectiveAccumulator.reset(static_cast<int>(allocations.size()));
+
+    auto retireEvent = [&](const Event& event) {
+        objectiveAccumulator.accumulate(event);
+
+        if (eventsFile.is_open()) {
+            writeEvent(eventsFile, event);
+        }
+    };
+
+    // simulate events pulled from the generator, arrivals are drawn from a stream separate from the simulator
+    const uint64_t generatorKey = splitMix64(static_cast<uint64_t>(config.seed));
+    EventGenerator eventGenerator(
+        monteCarloSimulator,
+        static_cast<std::mt19937::result_type>(generatorKey ^ (generatorKey >> 32))
+    );
+    Simulator simulator(config);
+    simulator.reset(eventGenerator, allocations, retireEvent);
+    simulator.run();
+
+    if (saveToFile) {
+        eventsFile.close();
+
+        writeGenotype(dirName, allocations, "genotype");
+        writeAmbulances(dirName, simulator.ambulanceAllocator.ambulances, "ambulances");
+
+        if (config.collectStats) {
+            saveDataToJson(dirName, "stats", simulator.stats.toDataMap());
+        }
+    }
+
+    if (verbose) {
+        printAmbulanceWorkload(simulator.ambulanceAllocator.ambulances);
+
+        std::cout
+            << "\nAvg. response time (A, urban): \t\t" << objectiveAccumulator.averageResponseTime("A", true) << "s" << std::endl
+            << "Avg. response time (A, non-urban): \t" << objectiveAccumulator.averageResponseTime("A", false) << "s" << std::endl
+            << "Avg. response time (H, urban): \t\t" << objectiveAccumulator.averageResponseTime("H", true) << "s" << std::endl
+            << "Avg. response time (H, non-urban): \t" << objectiveAccumulator.averageResponseTime("H", false) << "s" << std::endl
+            << "Avg. response time (V1, urban): \t" << objectiveAccumulator.averageResponseTime("V1", true) << "s" << std::endl
+            << "Avg. response time (V1, non-urban): \t" << objectiveAccumulator.averageResponseTime("V1", false) << "s" << std::endl
+            << "Percentage violations: \t\t\t" << objectiveAccumulator.responseTimeViolations() * 100 << "%" << std::endl
+            << "Percentage violations (U): \t\t" << objectiveAccumulator.responseTimeViolationsUrban(true) * 100 << "%" << std::endl
+            << "Percentage violations (R): \t\t" << objectiveAccumulator.responseTimeViolationsUrban(false) * 100 << "%" << std::endl;
+    }
+}
+
+void runRollingHorizon(
+    const int numDays,
+    const bool verbose,
+    const bool saveToFile,
+    std::vector<std::vector<int>> dayShiftAllocations,
+    std::vector<std::vector<int>> nightShiftAllocations
+) {
+    // set allocations to simplified OUH version, ambulances are carried over so both shifts need the same total
+    if (dayShiftAllocations.empty()) {
+        dayShiftAllocations = getSimplifiedOUHAllocations(true);
+    }
+    if (nightShiftAllocations.empty()) {
+        nightShiftAllocations = getSimplifiedOUHAllocations(false);
+    }
+
+    const SimulationConfig config = SimulationConfig::fromSettings();
+    const std::string dirName = Settings::get<std::string>("UNIQUE_RUN_ID") + "_ROLLING_HORIZON";
+
+    // consecutive shifts starting with the simulated shift on the simulated date
+    const int numShifts = numDays * 2;
+    const int firstDayShift = static_cast<int>(config.simulateDayShift);
+    SimClock::getInstance().setDate(
+        MonteCarloSimulator::year,
+        Settings::get<int>("SIMULATE_MONTH"),
+        Settings::get<int>("SIMULATE_DAY"),
+        numDays + 1
+    );
+
+    // finished events are written and accumulated as they leave the event queue, time segments of each shift
+    // get their own allocation index so metrics can be read per shift
+    std::ofstream eventsFile;
+    if (saveToFile) {
+        createDirectory(dirName);
+        eventsFile.open("../data/" + dirName + "/events.csv");
+        writeEventsHeader(eventsFile);
+    }
+
+    // date of each shift as month and day, a night shift ends on the morning of its date
+    auto getShiftDate = [&](const int shiftIndex) {
+        const int dayOffset = (shiftIndex + firstDayShift) / 2;
+
+        return SimClock::getInstance().toLocalTime(SimClock::getInstance().toSimulationTime(12, 0, 0, dayOffset));
+    };
+
+    std::vector<int> shiftFirstAllocationIndices;
+    std::vector<std::pair<int, int>> shiftDates;
+    int numAllocations = 0;
+    for (int shiftIndex = 0; shiftIndex < numShifts; shiftIndex++) {
+        const bool dayShift = (shiftIndex + firstDayShift) % 2 == 1;
+        const std::tm date = getShiftDate(shiftIndex);
+
+        shiftFirstAllocationIndices.push_back(numAllocations);
+        numAllocations += static_cast<int>(dayShift ? dayShiftAllocations.size() : nightShiftAllocations.size());
+        shiftDates.push_back({date.tm_mon + 1, date.tm_mday});
+    }
+    shiftFirstAllocationIndices.push_back(numAllocations);
+
+    // incidents are read once, each shift only builds the distributions of its date and shift from them
+    const std::vector<IncidentSample> incidentSamples = MonteCarloSimulator::readIncidentSamples(shiftDates);
+
+    ObjectiveAccumulator objectiveAccumulator;
+    objectiveAccumulator.reset(numAllocations);
+
+    auto retireEvent = [&](const Event& event) {
+        objectiveAccumulator.accumulate(event);
+
+        if (eventsFile.is_open()) {
+            writeEvent(eventsFile, event);
+        }
+    };
+
+    // shift start relative to the SimClock date, a night shift ends on the morning of its simulated date
+    auto getShiftStart = [&](const bool dayShift, const int dayOffset) {
+        return dayShift
+            ? SimClock::getInstance().toSimulationTime(config.dayShiftStart, 0, 0, dayOffset)
+            : SimClock::getInstance().toSimulationTime(config.dayShiftEnd + 1, 0, 0, dayOffset - 1);
+    };
+
+    const uint64_t seedKey = splitMix64(static_cast<uint64_t>(config.seed));
+    Simulator simulator(config);
+
+    // the generator of the previous shift is kept until its remaining arrivals are queued by the next shift
+    std::unique_ptr<MonteCarloSimulator> monteCarloSimulator;
+    std::unique_ptr<EventGenerator> eventGenerator;
+    for (int shiftIndex = 0; shiftIndex < numShifts; shiftIndex++) {
+        const bool dayShift = (shiftIndex + firstDayShift) % 2 == 1;
+        const int dayOffset = (shiftIndex + firstDayShift) / 2;
+        const std::tm date = getShiftDate(shiftIndex);
+
+        if (verbose) {
+            std::cout
+                << "\nShift " << (shiftIndex + 1) << "/" << numShifts << ": "
+                << (dayShift ? "day" : "night") << " shift of " << date.tm_mday << "." << (date.tm_mon + 1) << std::endl;
+        }
+
+        // distributions are built for the date of each shift, only the first shift has a warm-up hour
+        std::unique_ptr<MonteCarloSimulator> nextMonteCarloSimulator = std::make_unique<MonteCarloSimulator>(
+            incidentSamples,
+            date.tm_mon + 1,
+            date.tm_mday,
+            dayShift,
+            shiftIndex == 0 && config.simulate1HourBefore,
+            dayOffset
+        );
+
+        // each shift draws its arrivals from its own stream, stream keys of the arrivals continue from the previous shift
+        const uint64_t key = splitMix64(seedKey ^ static_cast<uint64_t>(shiftIndex));
+        std::unique_ptr<EventGenerator> nextEventGenerator = std::make_unique<EventGenerator>(
+            *nextMonteCarloSimulator,
+            static_cast<std::mt19937::result_type>(key ^ (key >> 32)),
+            eventGenerator == nullptr ? 0 : eventGenerator->getEndRandomStreamKey()
+        );
+
+        const std::vector<std::vector<int>>& allocations = dayShift ? dayShiftAllocations : nightShiftAllocations;
+        if (shiftIndex == 0) {
+            simulator.reset(*nextEventGenerator, allocations, retireEvent);
+        } else {
+            simulator.startShift(*nextEventGenerator, allocations, getShiftStart(dayShift, dayOffset));
+        }
+
+        eventGenerator = std::move(nextEventGenerator);
+        monteCarloSimulator = std::move(nextMonteCarloSimulator);
+
+        // the last shift runs until every event is finished
+        if (shiftIndex + 1 < numShifts) {
+            const int nextDayOffset = (shiftIndex + 1 + firstDayShift) / 2;
+
+            simulator.runUntil(getShiftStart(!dayShift, nextDayOffset));
+        } else {
+            simulator.run();
+        }
+    }
+
+    if (saveToFile) {
+        eventsFile.close();
+
+        writeGenotype(dirName, simulator.ambulanceAllocator.genotype, "genotype");
+        writeAmbulances(dirName, simulator.ambulanceAllocator.ambulances, "ambulances");
+
+        if (config.collectStats) {
+            saveDataToJson(dirName, "stats", simulator.stats.toDataMap());
+        }
+    }
+
+    if (verbose) {
+        std::cout << std::endl;
+
+        for (int shiftIndex = 0; shiftIndex < numShifts; shiftIndex++) {
+            const int firstAllocationIndex = shiftFirstAllocationIndices[shiftIndex];
+            const int lastAllocationIndex = shiftFirstAllocationIndices[shiftIndex + 1];
+
+            for (int allocationIndex = firstAllocationIndex; allocationIndex < lastAllocationIndex; allocationIndex++) {
+                std::cout
+                    << "Percentage violations (shift " << (shiftIndex + 1)
+                    << ", segment " << (allocationIndex - firstAllocationIndex + 1) << "): \t"
+                    << objectiveAccumulator.responseTimeViolations(allocationIndex) * 100 << "%" << std::endl;
+            }
+        }
+
+        std::cout
+            << "\nAvg. response time (A, urban): \t\t" << objectiveAccumulator.averageResponseTime("A", true) << "s" << std::endl
+            << "Avg. response time (A, non-urban): \t" << objectiveAccumulator.averageResponseTime("A", false) << "s" << std::endl
+            << "Avg. response time (H, urban): \t\t" << objectiveAccumulator.averageResponseTime("H", true) << "s" << std::endl
+            << "Avg. response time (H, non-urban): \t" << objectiveAccumulator.averageResponseTime("H", false) << "s" << std::endl
+            << "Avg. response time (V1, urban): \t" << objectiveAccumulator.averageResponseTime("V1", true) << "s" << std::endl
+            << "Avg. response time (V1, non-urban): \t" << objectiveAccumulator.averageResponseTime("V1", false) << "s" << std::endl
+            << "Percentage violations: \t\t\t" << objectiveAccumulator.responseTimeViolations() * 100 << "%" << std::endl
+            << "Percentage violations (U): \t\t" << objectiveAccumulator.responseTimeViolationsUrban(true) * 100 << "%" << std::endl
+            << "Percentage violations (R): \t\t" << objectiveAccumulator.responseTimeViolationsUrban(false) * 100 << "%" << std::endl;
+    }
+}
+
+void runGeneticAlgorithm(const std::vector<Event>& events, const std::vector<std::vector<Event>>& scenarios) {
+    PopulationGA population(events, scenarios);
     population.evolve();
 }
 
-void runNSGA2(const std::vector<Event>& events) {
-    PopulationNSGA2 population(events);
+void runNSGA2(const std::vector<Event>& events, const std::vector<std::vector<Event>>& scenarios) {
+    PopulationNSGA2 population(events, scenarios);
     population.evolve();
 }
 
-void runMemeticAlgorithm(const std::vector<Event>& events) {
-    PopulationMA population(events);
+void runMemeticAlgorithm(const std::vector<Event>& events, const std::vector<std::vector<Event>>& scenarios) {
+    PopulationMA population(events, scenarios);
     population.evolve();
 }
 
-void runMemeticNSGA2(const std::vector<Event>& events) {
-    PopulationMemeticNSGA2 population(events);
+void runMemeticNSGA2(const std::vector<Event>& events, const std::vector<std::vector<Event>>& scenarios) {
+    PopulationMemeticNSGA2 population(events, scenarios);
     population.evolve();
 }
 
@@ -205,14 +461,14 @@ void runDataValidation(std::vector<Event>& events) {
                 continue;
             }
 
-            event.updateTimer(static_cast<int>(event.secondsWaitResourcePreparingDeparture), "duration_resource_preparing_departure");
+            event.updateTimer(static_cast<int>(event.secondsWaitResourcePreparingDeparture), EventMetric::DURATION_RESOURCE_PREPARING_DEPARTURE);
 
             const bool cancelledEvent = event.secondsWaitDepartureScene == -1;
             if (!cancelledEvent) {
-                event.updateTimer(static_cast<int>(event.secondsWaitDepartureScene), "duration_at_scene");
-                event.updateTimer(static_cast<int>(event.secondsWaitAvailable), "duration_at_hospital");
+                event.updateTimer(static_cast<int>(event.secondsWaitDepartureScene), EventMetric::DURATION_AT_SCENE);
+                event.updateTimer(static_cast<int>(event.secondsWaitAvailable), EventMetric::DURATION_AT_HOSPITAL);
             } else {
-                event.updateTimer(static_cast<int>(event.secondsWaitAvailable), "duration_at_scene");
+                event.updateTimer(static_cast<int>(event.secondsWaitAvailable), EventMetric::DURATION_AT_SCENE);
             }
         }
 
@@ -5,30 +5,35 @@
  */
 
 /* external libraries */
-#include <map>
 #include <iomanip>
 #include <algorithm>
 #include <ctime>
+#include <numeric>
+#include <string>
 /* internal libraries */
 #include "simulator/AmbulanceAllocator.hpp"
-#include "file-reader/Settings.hpp"
-#include "file-reader/Stations.hpp"
+#include "simulator/SimClock.hpp"
+#include "Utils.hpp"
 
 void AmbulanceAllocator::allocate(
     std::vector<Event>& events,
     const std::vector<std::vector<int>>& allocations,
-    const bool dayshift
+    const SimulationConfig& config
 ) {
+    // keep a copy of the genotype, reallocation events refer to it by allocation index
+    genotype = allocations;
+
     ambulances.clear();
 
-    std::vector<unsigned> depotIndices = Stations::getInstance().getDepotIndices(dayshift);
+    const bool dayshift = config.simulateDayShift;
+    const std::vector<unsigned>& depotIndices = config.getDepotIndices(dayshift);
 
     // convert genotype to ambulances, init to first time segment
     int ambulanceId = 0;
-    for (int depotId = 0; depotId < allocations[0].size(); depotId++) {
+    for (size_t depotId = 0; depotId < allocations[0].size(); depotId++) {
         int depotIndex = depotIndices[depotId];
         int numberOfAmbulancesInDepot = allocations[0][depotId];
-        const int64_t depotGridId = Stations::getInstance().get<int64_t>("grid_id", depotIndex);
+        const int64_t depotGridId = config.stationGridIds[depotIndex];
 
         for (int i = 0; i < numberOfAmbulancesInDepot; i++) {
             Ambulance ambulance;
@@ -40,16 +45,17 @@ void AmbulanceAllocator::allocate(
         }
     }
 
-    // get shift start and end timers
-    std::tm shiftStartTm = getLocalTime(events[events.size() - 1].timer);
-
-    shiftStartTm.tm_hour = Settings::get<int>("DAY_SHIFT_START");
-    shiftStartTm.tm_min = 0;
-    shiftStartTm.tm_sec = 0;
+    // track ambulance states for quick lookup of available ambulances
+    availabilityIndex.reset(static_cast<int>(ambulances.size()));
+    for (Ambulance& ambulance : ambulances) {
+        ambulance.availabilityIndex = &availabilityIndex;
+        availabilityIndex.setDepot(ambulance.id, ambulance.allocatedDepotIndex);
+    }
 
+    // get shift start and end timers
     int shiftLengthSeconds = (12 * 60) * 60;
 
-    time_t shiftStart = std::mktime(&shiftStartTm);
+    time_t shiftStart = SimClock::getInstance().toSimulationTime(config.dayShiftStart);
     time_t shiftEnd = shiftStart + shiftLengthSeconds;
 
     if (!dayshift) {
@@ -58,8 +64,8 @@ void AmbulanceAllocator::allocate(
     }
 
     // schedule breaks if policy is on
-    if (Settings::get<bool>("SCHEDULE_BREAKS")) {
-        allocateAndScheduleBreaks(shiftStart, shiftEnd);
+    if (config.scheduleBreaks) {
+        allocateAndScheduleBreaks(events, config, allocations[0], depotIndices, shiftStart, shiftEnd);
     }
 
     // add reallocation events
@@ -73,42 +79,137 @@ void AmbulanceAllocator::allocate(
             Event event;
             event.type = EventType::REALLOCATE;
             event.timer = reallocationTime;
-            event.reallocation = allocations[reallocationIndex];
+            event.allocationIndex = static_cast<int>(reallocationIndex);
             event.utility = true;
+            event.randomStreamKey = deriveStreamKey(
+                static_cast<uint64_t>(EventType::REALLOCATE),
+                static_cast<uint64_t>(event.allocationIndex)
+            );
             // define call received for sorting in utility functions
-            event.callReceived = getLocalTime(reallocationTime);
+            event.callReceived = reallocationTime;
 
             events.push_back(event);
         }
+    }
 
+    if (config.scheduleBreaks || allocations.size() > 1) {
         std::sort(events.begin(), events.end(), [](const Event& a, const Event& b) {
             return a.timer < b.timer;
         });
     }
 }
 
-void AmbulanceAllocator::allocateAndScheduleBreaks(const time_t& shiftStart, const time_t& shiftEnd) {
-    std::map<int, int> depotAmbulanceCounts;
-    std::map<int, int> depotAmbulanceOrdered;
+void AmbulanceAllocator::scheduleShift(
+    std::vector<Event>& events,
+    const std::vector<std::vector<int>>& allocations,
+    const SimulationConfig& config,
+    const time_t& shiftStart
+) {
+    // ambulances are carried over, so every time segment of the next shift has to place all of them
+    for (const std::vector<int>& allocation : allocations) {
+        const int numAmbulances = std::accumulate(allocation.begin(), allocation.end(), 0);
+
+        if (numAmbulances != static_cast<int>(ambulances.size())) {
+            throwError(
+                "Shift allocation has " + std::to_string(numAmbulances) + " ambulances, expected the "
+                + std::to_string(ambulances.size()) + " carried over from the previous shift."
+            );
+        }
+    }
 
-    for (Ambulance& ambulance : ambulances) {
-        depotAmbulanceCounts[ambulance.allocatedDepotIndex]++;
+    // time segments of the next shift continue the genotype, ambulances keep their state from the previous shift
+    const int firstAllocationIndex = static_cast<int>(genotype.size());
+    genotype.insert(genotype.end(), allocations.begin(), allocations.end());
+
+    int shiftLengthSeconds = (12 * 60) * 60;
+    time_t shiftEnd = shiftStart + shiftLengthSeconds;
+
+    // breaks are spread out by the depots of the new shift, which the first reallocation moves ambulances to
+    if (config.scheduleBreaks) {
+        const std::vector<unsigned>& depotIndices = config.getDepotIndices(config.isDayShift(shiftStart));
+
+        allocateAndScheduleBreaks(events, config, allocations[0], depotIndices, shiftStart, shiftEnd);
     }
 
+    // the first reallocation event moves ambulances to the depots of the new shift
+    int reallocationInterval = shiftLengthSeconds / static_cast<int>(allocations.size());
+
+    for (size_t reallocationIndex = 0; reallocationIndex < allocations.size(); reallocationIndex++) {
+        time_t reallocationTime = shiftStart + reallocationInterval * reallocationIndex;
+
+        Event event;
+        event.type = EventType::REALLOCATE;
+        event.timer = reallocationTime;
+        event.allocationIndex = firstAllocationIndex + static_cast<int>(reallocationIndex);
+        event.utility = true;
+        event.randomStreamKey = deriveStreamKey(
+            static_cast<uint64_t>(EventType::REALLOCATE),
+            static_cast<uint64_t>(event.allocationIndex)
+        );
+        // define call received for sorting in utility functions
+        event.callReceived = reallocationTime;
+
+        events.push_back(event);
+    }
+}
+
+void AmbulanceAllocator::allocateAndScheduleBreaks(
+    std::vector<Event>& events,
+    const SimulationConfig& config,
+    const std::vector<int>& allocation,
+    const std::vector<unsigned>& depotIndices,
+    const time_t& shiftStart,
+    const time_t& shiftEnd
+) {
+    // count ambulances per depot of the allocation, buffers are reused between allocations
+    depotAmbulanceCounts.assign(config.stationGridIds.size(), 0);
+    depotAmbulanceOrdered.assign(config.stationGridIds.size(), 0);
+
+    for (size_t depotId = 0; depotId < allocation.size(); depotId++) {
+        depotAmbulanceCounts[depotIndices[depotId]] += allocation[depotId];
+    }
+
+    // ambulances take the depot slots of the allocation in id order, the same order allocate creates them in
+    size_t depotId = 0;
+    int remainingInDepot = allocation.empty() ? 0 : allocation[0];
     for (Ambulance& ambulance : ambulances) {
-        int depotIndex = ambulance.allocatedDepotIndex;
+        while (remainingInDepot <= 0 && depotId + 1 < allocation.size()) {
+            remainingInDepot = allocation[++depotId];
+        }
+        remainingInDepot--;
+
+        int depotIndex = depotIndices[depotId];
         int ambulanceIndexWithinDepot = depotAmbulanceOrdered[depotIndex]++;
         int depotSize = depotAmbulanceCounts[depotIndex];
 
-        ambulance.scheduleBreaks(shiftStart, shiftEnd, depotSize, ambulanceIndexWithinDepot);
+        std::pair<time_t, time_t> breakTimes = ambulance.getBreakTimes(
+            shiftStart,
+            shiftEnd,
+            depotSize,
+            ambulanceIndexWithinDepot
+        );
+
+        // breaks are utility events processed in the event queue like any other event,
+        // their stream keys depend on the shift and ambulance only and not on the depot it is allocated to
+        uint64_t randomStreamKey = deriveStreamKey(static_cast<uint64_t>(shiftStart), static_cast<uint64_t>(ambulance.id));
+        for (const time_t& breakTime : {breakTimes.first, breakTimes.second}) {
+            randomStreamKey = deriveStreamKey(randomStreamKey, static_cast<uint64_t>(EventType::START_BREAK));
+
+            Event event;
+            event.id = static_cast<int>(events.size());
+            event.type = EventType::START_BREAK;
+            event.timer = breakTime;
+            event.prevTimer = breakTime;
+            event.callReceived = breakTime;
+            event.ambulanceIdResponsible = ambulance.id;
+            event.utility = true;
+            event.randomStreamKey = randomStreamKey;
+
+            events.push_back(event);
+        }
 
         /*std::cout << "Ambulance ID: " << ambulance.id << ", Depot Index: " << depotIndex
                     << ", Ambulance Index Within Depot: " << ambulanceIndexWithinDepot
-                    << ", Depot Size: " << depotSize << std::endl;
-
-        for (time_t breakTime : ambulance.scheduledBreaks) {
-            std::tm ptm =  getLocalTime(breakTime);
-            std::cout << "Scheduled Break: " << std::put_time(ptm, "%Y-%m-%d %H:%M:%S") << std::endl;
-        }*/
+                    << ", Depot Size: " << depotSize << std::endl;*/
     }
 }
@@ -0,0 +1,99 @@
+/**
+ * @file AvailabilityIndex.cpp
+ *
+ * @copyright Copyright (c) 2024 Emergency-Optimizers
+ */
+
+/* external libraries */
+#include <cstddef>
+/* internal libraries */
+#include "simulator/AvailabilityIndex.hpp"
+
+void AvailabilityIndex::reset(const int numAmbulances) {
+    const size_t numStates = static_cast<size_t>(AmbulanceState::BUSY) + 1;
+
+    // every ambulance starts idle at its depot
+    ambulancesInState.resize(numStates);
+    for (std::vector<int>& ambulances : ambulancesInState) {
+        ambulances.clear();
+    }
+
+    states.assign(numAmbulances, AmbulanceState::IDLE);
+    positions.resize(numAmbulances);
+    depots.assign(numAmbulances, -1);
+    idleInDepot.clear();
+
+    for (int ambulanceIndex = 0; ambulanceIndex < numAmbulances; ambulanceIndex++) {
+        positions[ambulanceIndex] = ambulanceIndex;
+        ambulancesInState[static_cast<size_t>(AmbulanceState::IDLE)].push_back(ambulanceIndex);
+    }
+}
+
+void AvailabilityIndex::setState(const int ambulanceIndex, const AmbulanceState state) {
+    const AmbulanceState oldState = states[ambulanceIndex];
+    if (oldState == state) {
+        return;
+    }
+
+    // remove from old set by moving the last ambulance into its place
+    std::vector<int>& oldAmbulances = ambulancesInState[static_cast<size_t>(oldState)];
+    const int lastAmbulanceIndex = oldAmbulances.back();
+    oldAmbulances[positions[ambulanceIndex]] = lastAmbulanceIndex;
+    positions[lastAmbulanceIndex] = positions[ambulanceIndex];
+    oldAmbulances.pop_back();
+
+    // add to new set
+    std::vector<int>& newAmbulances = ambulancesInState[static_cast<size_t>(state)];
+    positions[ambulanceIndex] = static_cast<int>(newAmbulances.size());
+    newAmbulances.push_back(ambulanceIndex);
+
+    states[ambulanceIndex] = state;
+
+    // update idle count of the depot if the ambulance became idle or stopped being idle
+    const int depotIndex = depots[ambulanceIndex];
+    if (depotIndex != -1) {
+        if (oldState == AmbulanceState::IDLE) {
+            idleInDepot[depotIndex]--;
+        } else if (state == AmbulanceState::IDLE) {
+            idleInDepot[depotIndex]++;
+        }
+    }
+}
+
+void AvailabilityIndex::setDepot(const int ambulanceIndex, const int depotIndex) {
+    const int oldDepotIndex = depots[ambulanceIndex];
+    if (oldDepotIndex == depotIndex) {
+        return;
+    }
+
+    if (depotIndex >= static_cast<int>(idleInDepot.size())) {
+        idleInDepot.resize(depotIndex + 1, 0);
+    }
+
+    // move the ambulance's contribution to the idle count over to the new depot
+    if (states[ambulanceIndex] == AmbulanceState::IDLE) {
+        if (oldDepotIndex != -1) {
+            idleInDepot[oldDepotIndex]--;
+        }
+
+        idleInDepot[depotIndex]++;
+    }
+
+    depots[ambulanceIndex] = depotIndex;
+}
+
+AmbulanceState AvailabilityIndex::getState(const int ambulanceIndex) const {
+    return states[ambulanceIndex];
+}
+
+const std::vector<int>& AvailabilityIndex::getAmbulances(const AmbulanceState state) const {
+    return ambulancesInState[static_cast<size_t>(state)];
+}
+
+int AvailabilityIndex::getIdleInDepot(const int depotIndex) const {
+    if (depotIndex < 0 || depotIndex >= static_cast<int>(idleInDepot.size())) {
+        return 0;
+    }
+
+    return idleInDepot[depotIndex];
+}
@@ -8,7 +8,13 @@
 #include "simulator/Event.hpp"
 #include "simulator/Ambulance.hpp"
 
-void Event::updateTimer(const int increment, const std::string& metric, const bool dontUpdateTimer) {
+void Event::setType(const EventType newType) {
+    type = newType;
+
+    updateAmbulanceState();
+}
+
+void Event::updateTimer(const int increment, const EventMetric metric, const bool dontUpdateTimer) {
     if (!dontUpdateTimer) {
         // set previous timer to handle reassignment events
         prevTimer = timer;
@@ -16,20 +22,20 @@ void Event::updateTimer(const int increment, const std::string& metric, const bo
     }
 
     // update metrics if defined, used when writing events.csv file for analysing
-    if (!metric.empty()) {
-        if (metrics[metric] == -1) {
-            metrics[metric] = increment;
+    if (metric != EventMetric::NONE) {
+        if (getMetric(metric) == -1) {
+            getMetric(metric) = increment;
         } else {
-            metrics[metric] += increment;
+            getMetric(metric) += increment;
         }
 
         // update ambulance UHU if applicable
-        bool updateAmbulance = metric == "duration_resource_preparing_departure";
-        updateAmbulance |= metric == "duration_dispatching_to_scene";
-        updateAmbulance |= metric == "duration_at_scene";
-        updateAmbulance |= metric == "duration_dispatching_to_hospital";
-        updateAmbulance |= metric == "duration_at_hospital";
-        updateAmbulance |= metric == "duration_dispatching_to_depot";
+        bool updateAmbulance = metric == EventMetric::DURATION_RESOURCE_PREPARING_DEPARTURE;
+        updateAmbulance |= metric == EventMetric::DURATION_DISPATCHING_TO_SCENE;
+        updateAmbulance |= metric == EventMetric::DURATION_AT_SCENE;
+        updateAmbulance |= metric == EventMetric::DURATION_DISPATCHING_TO_HOSPITAL;
+        updateAmbulance |= metric == EventMetric::DURATION_AT_HOSPITAL;
+        updateAmbulance |= metric == EventMetric::DURATION_DISPATCHING_TO_DEPOT;
 
         if (assignedAmbulance != nullptr && updateAmbulance) {
             assignedAmbulance->timeUnavailable += increment;
@@ -37,12 +43,20 @@ void Event::updateTimer(const int increment, const std::string& metric, const bo
     }
 }
 
-int Event::getResponseTime() {
+int& Event::getMetric(const EventMetric metric) {
+    return metrics[static_cast<size_t>(metric)];
+}
+
+int Event::getMetric(const EventMetric metric) const {
+    return metrics[static_cast<size_t>(metric)];
+}
+
+int Event::getResponseTime() const {
     // calculate response time for event
-    int responseTime = metrics["duration_incident_creation"];
-    responseTime += metrics["duration_resource_appointment"];
-    responseTime += metrics["duration_resource_preparing_departure"];
-    responseTime += metrics["duration_dispatching_to_scene"];
+    int responseTime = getMetric(EventMetric::DURATION_INCIDENT_CREATION);
+    responseTime += getMetric(EventMetric::DURATION_RESOURCE_APPOINTMENT);
+    responseTime += getMetric(EventMetric::DURATION_RESOURCE_PREPARING_DEPARTURE);
+    responseTime += getMetric(EventMetric::DURATION_DISPATCHING_TO_SCENE);
 
     return responseTime;
 }
@@ -51,19 +65,43 @@ int Event::getResponseTime() {
 void Event::removeAssignedAmbulance() {
     if (assignedAmbulance != nullptr) {
         assignedAmbulance->assignedEventId = -1;
+        assignedAmbulance->setState(AmbulanceState::IDLE);
         assignedAmbulance = nullptr;
     }
 }
 
 void Event::assignAmbulance(Ambulance& ambulance) {
     // make sure to deassign any old ambulances if needed
-    if (assignedAmbulance != nullptr) {
-        assignedAmbulance->assignedEventId = -1;
-    }
+    removeAssignedAmbulance();
 
     assignedAmbulance = &ambulance;
     assignedAmbulance->assignedEventId = id;
     depotIndexResponsible = assignedAmbulance->allocatedDepotIndex;
     ambulanceIdResponsible = assignedAmbulance->id;
     allocationIndex = assignedAmbulance->currentAllocationIndex;
+
+    updateAmbulanceState();
+}
+
+void Event::updateAmbulanceState() {
+    if (assignedAmbulance == nullptr) {
+        return;
+    }
+
+    // only ambulances travelling to a scene or back to a depot can be picked for other events
+    switch (type) {
+        case EventType::DISPATCHING_TO_SCENE:
+            assignedAmbulance->sceneTriageImpression = triageImpression;
+            assignedAmbulance->setState(AmbulanceState::DISPATCHING_TO_SCENE);
+            break;
+        case EventType::DISPATCHING_TO_DEPOT:
+            assignedAmbulance->setState(AmbulanceState::DISPATCHING_TO_DEPOT);
+            break;
+        case EventType::END_BREAK:
+            assignedAmbulance->setState(AmbulanceState::ON_BREAK);
+            break;
+        default:
+            assignedAmbulance->setState(AmbulanceState::BUSY);
+            break;
+    }
 }
@@ -0,0 +1,82 @@
+/**
+ * @file EventGenerator.cpp
+ *
+ * @copyright Copyright (c) 2024 Emergency-Optimizers
+ */
+
+/* external libraries */
+#include <algorithm>
+/* internal libraries */
+#include "simulator/EventGenerator.hpp"
+#include "simulator/SimClock.hpp"
+#include "Utils.hpp"
+
+EventGenerator::EventGenerator(
+    const MonteCarloSimulator& monteCarloSimulator,
+    const std::mt19937::result_type seed,
+    const uint64_t firstRandomStreamKey
+) : monteCarloSimulator(monteCarloSimulator), rnd(seed), nextRandomStreamKey(firstRandomStreamKey) {
+    // draw how many arrivals fall in each hour up front, the arrivals themselves are generated when their hour is reached
+    const int totalEvents = monteCarloSimulator.getTotalIncidentsToGenerate();
+    for (int i = 0; i < totalEvents; i++) {
+        hourlyCounts[monteCarloSimulator.sampleCallReceivedHour(rnd)]++;
+    }
+    endRandomStreamKey = firstRandomStreamKey + static_cast<uint64_t>(std::max(totalEvents, 0));
+
+    for (size_t hour = 0; hour < hourlyCounts.size(); hour++) {
+        if (hourlyCounts[hour] > 0) {
+            hours.push_back(static_cast<int>(hour));
+        }
+    }
+
+    // night shift hours wrap around midnight, so order by simulation time instead of hour of day
+    std::sort(hours.begin(), hours.end(), [&](const int a, const int b) {
+        return SimClock::getInstance().toSimulationTime(a, 0, 0, monteCarloSimulator.getCallReceivedDay(a))
+            < SimClock::getInstance().toSimulationTime(b, 0, 0, monteCarloSimulator.getCallReceivedDay(b));
+    });
+}
+
+void EventGenerator::generateNextHour() {
+    const int hour = hours[nextHourIndex++];
+
+    // sorted arrival offsets in seconds within the hour
+    arrivalOffsets.clear();
+    for (int i = 0; i < hourlyCounts[hour]; i++) {
+        arrivalOffsets.push_back(getRandomInt(rnd, 0, 3599));
+    }
+    std::sort(arrivalOffsets.begin(), arrivalOffsets.end());
+
+    hourEvents.clear();
+    nextEventIndex = 0;
+    for (const int arrivalOffset : arrivalOffsets) {
+        hourEvents.push_back(monteCarloSimulator.generateEvent(rnd, hour, arrivalOffset / 60, arrivalOffset % 60));
+    }
+}
+
+uint64_t EventGenerator::getEndRandomStreamKey() const {
+    return endRandomStreamKey;
+}
+
+bool EventGenerator::hasNext() {
+    // generate the next hour with arrivals once the current hour is used up
+    while (nextEventIndex == hourEvents.size() && nextHourIndex < hours.size()) {
+        generateNextHour();
+    }
+
+    return nextEventIndex < hourEvents.size();
+}
+
+const time_t& EventGenerator::peekCallReceived() {
+    hasNext();
+
+    return hourEvents[nextEventIndex].callReceived;
+}
+
+Event EventGenerator::next() {
+    hasNext();
+
+    Event event = hourEvents[nextEventIndex++];
+    event.randomStreamKey = nextRandomStreamKey++;
+
+    return event;
+}
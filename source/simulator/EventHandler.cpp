@@ -5,22 +5,132 @@
  */
 
 /* external libraries */
+#include <algorithm>
 #include <ctime>
 /* internal libraries */
 #include "simulator/EventHandler.hpp"
+#include "simulator/Ambulance.hpp"
 #include "Utils.hpp"
 
-EventHandler::EventHandler(std::vector<Event>& events) : events(events) {
-    sortEvents();
+void EventHandler::reset(const std::vector<Event>& newEvents, const int newCurrentIndex) {
+    // copy into existing buffer to reuse its memory between simulations
+    events = newEvents;
+    currentIndex = newCurrentIndex;
+    eventGenerator = nullptr;
+    retireEvent = nullptr;
+}
+
+void EventHandler::reset(EventGenerator& newEventGenerator, const std::function<void(const Event&)>& newRetireEvent) {
+    // arrivals are pulled from the generator as the simulation reaches them
+    events.clear();
+    currentIndex = 0;
+    eventGenerator = &newEventGenerator;
+    retireEvent = newRetireEvent;
+    nextEventId = 0;
+}
+
+void EventHandler::resume(const SimulationCheckpoint& checkpoint) {
+    // finished events are spread over the chain of checkpoints, restore them oldest first
+    std::vector<const SimulationCheckpoint*> chain;
+    for (const SimulationCheckpoint* link = &checkpoint; link != nullptr; link = link->previous.get()) {
+        chain.push_back(link);
+    }
+
+    events.clear();
+    for (std::vector<const SimulationCheckpoint*>::reverse_iterator link = chain.rbegin(); link != chain.rend(); link++) {
+        events.insert(events.end(), (*link)->finishedEvents.begin(), (*link)->finishedEvents.end());
+    }
+    events.insert(events.end(), checkpoint.pendingEvents.begin(), checkpoint.pendingEvents.end());
+
+    currentIndex = checkpoint.numFinishedEvents;
+    eventGenerator = nullptr;
+    retireEvent = nullptr;
+}
+
+void EventHandler::setEventGenerator(EventGenerator& newEventGenerator) {
+    // queue the arrivals left in the current generator so it can be released
+    while (eventGenerator->hasNext()) {
+        insertEvent(eventGenerator->next());
+    }
+
+    eventGenerator = &newEventGenerator;
+}
+
+int EventHandler::getCurrentIndex() const {
+    return currentIndex;
 }
 
 int EventHandler::getNextEventIndex() {
     // iterate through queue until event which isn't finsihed appears
-    for (; currentIndex < events.size(); currentIndex++) {
-        if (events[currentIndex].type != EventType::NONE) return currentIndex;
+    for (; static_cast<size_t>(currentIndex) < events.size(); currentIndex++) {
+        if (events[currentIndex].type != EventType::NONE) break;
     }
 
-    return -1;
+    if (eventGenerator != nullptr) {
+        retireEvents();
+        pullEvents();
+    }
+
+    return static_cast<size_t>(currentIndex) < events.size() ? currentIndex : -1;
+}
+
+void EventHandler::pullEvents() {
+    // pull arrivals until the event after the next one is known, handlers look ahead to it when postponing.
+    // arrivals left in the generator are received later than that event, so they can't be processed before it
+    while (eventGenerator->hasNext()) {
+        const bool nextEventKnown = static_cast<size_t>(currentIndex) + 1 < events.size();
+        if (nextEventKnown && eventGenerator->peekCallReceived() > events[currentIndex + 1].timer) {
+            break;
+        }
+
+        insertEvent(eventGenerator->next());
+    }
+}
+
+void EventHandler::insertEvent(Event event) {
+    event.id = nextEventId++;
+
+    std::vector<Event>::iterator position = std::upper_bound(
+        events.begin() + currentIndex,
+        events.end(),
+        event,
+        [](const Event& a, const Event& b) { return a.timer < b.timer; }
+    );
+    events.insert(position, event);
+}
+
+void EventHandler::retireEvents() {
+    // events before the current index are finished, remove them once they make up half of the queue
+    if (currentIndex == 0 || static_cast<size_t>(currentIndex) * 2 < events.size()) {
+        return;
+    }
+
+    if (retireEvent) {
+        for (int i = 0; i < currentIndex; i++) {
+            retireEvent(events[i]);
+        }
+    }
+
+    events.erase(events.begin(), events.begin() + currentIndex);
+    currentIndex = 0;
+}
+
+void EventHandler::assignNewEventIds(const size_t firstIndex, const size_t numEvents) {
+    // handlers number new events by queue size, which repeats ids once finished events are retired
+    if (eventGenerator == nullptr) {
+        return;
+    }
+
+    for (size_t i = firstIndex; i < firstIndex + numEvents; i++) {
+        Event& event = events[i];
+        const int oldId = event.id;
+
+        event.id = nextEventId++;
+
+        if (event.assignedAmbulance != nullptr && event.assignedAmbulance->assignedEventId == oldId) {
+            event.assignedAmbulance->assignedEventId = event.id;
+        }
+    }
 }
 
 void EventHandler::sortEvent(size_t eventIndex) {
@@ -38,14 +148,14 @@ void EventHandler::sortEvent(size_t eventIndex) {
 }
 
 void EventHandler::sortEvents() {
-    // sort all events
-    std::sort(events.begin(), events.end(), [](const Event& a, const Event& b) {
+    // sort all unprocessed events, finished events before the current index keep their place
+    std::sort(events.begin() + currentIndex, events.end(), [](const Event& a, const Event& b) {
         return a.timer < b.timer;
     });
 
-    for (int i = 0; i < events.size(); i++) {
+    for (size_t i = currentIndex; i < events.size(); i++) {
         if (events[i].type != EventType::NONE) {
-            currentIndex = i;
+            currentIndex = static_cast<int>(i);
             break;
         }
     }
@@ -6,69 +6,54 @@
 
 /* external libraries */
 #include <algorithm>
+#include <cmath>
 #include <iomanip>
+#include <limits>
+#include <memory>
 #include <numeric>
+#include <thread>
 /* internal libraries */
 #include "simulator/MonteCarloSimulator.hpp"
+#include "simulator/SimClock.hpp"
 #include "Constants.hpp"
 #include "ProgressBar.hpp"
 #include "Utils.hpp"
 #include "file-reader/Incidents.hpp"
 
 MonteCarloSimulator::MonteCarloSimulator() {
-    ProgressBar progressBar(12, "Generating MCS");
-    size_t progress = 0;
-
-    // get subset within window size defined in settings.txt
-    filteredIncidents = Incidents::getInstance().rowsWithinTimeFrame(month, day, windowSize);
-    progressBar.update(++progress);
-
-    weights = generateWeights(windowSize);
-    for (int i = 0, indexGridId = 0; i < Incidents::getInstance().size(); i++) {
-        int64_t gridId = Incidents::getInstance().get<int64_t>("grid_id", i);
-
-        if (gridIdToIndexMapping.count(gridId)) continue;
-
-        indexToGridIdMapping[indexGridId] = gridId;
-
-        gridIdToIndexMapping[gridId] = indexGridId;
-
-        indexGridId++;
-    }
-    progressBar.update(++progress);
-
-    // generate distributions
-    generateHourlyIncidentProbabilityDistribution();
-    progressBar.update(++progress);
-
-    generateTriageProbabilityDistribution();
-    progressBar.update(++progress);
-
-    generateCanceledProbabilityDistribution();
-    progressBar.update(++progress);
-
-    generateLocationProbabilityDistribution();
-    progressBar.update(++progress);
+    // all simulation times are relative to the simulated date
+    SimClock::getInstance().setDate(year, month, day);
 
-    // generate KDE data for each delay
-    generateDurationsData("time_call_received", "time_incident_created");
-    progressBar.update(++progress);
+    ProgressBar progressBar(4, "Generating MCS");
+    size_t progress = 0;
 
-    generateDurationsData("time_incident_created", "time_resource_appointed");
+    // read every incident once, then build all distributions and delay samples from the compact samples
+    const std::vector<IncidentSample> incidentSamples = readIncidentSamples({{month, day}});
     progressBar.update(++progress);
 
-    generateDurationsData("time_resource_appointed", "time_ambulance_dispatch_to_scene");
+    generateDistributions(incidentSamples);
     progressBar.update(++progress);
 
-    generateDurationsData("time_ambulance_arrived_at_scene", "time_ambulance_dispatch_to_hospital");
+    generateKDEs();
     progressBar.update(++progress);
 
-    generateDurationsData("time_ambulance_arrived_at_hospital", "time_ambulance_available");
+    generateSamplers();
     progressBar.update(++progress);
+}
 
-    const bool filterToCancelledEvents = true;
-    generateDurationsData("time_ambulance_arrived_at_scene", "time_ambulance_available", filterToCancelledEvents);
-    progressBar.update(++progress);
+MonteCarloSimulator::MonteCarloSimulator(
+    const std::vector<IncidentSample>& incidentSamples,
+    const int month,
+    const int day,
+    const bool dayShift,
+    const bool simulate1HourBefore,
+    const int dayOffset
+) : month(month), day(day), dayShift(dayShift), simulate1HourBefore(simulate1HourBefore), rollingHorizon(true), dayOffset(dayOffset) {
+    // incidents are read and the SimClock date is set once for the whole rolling horizon,
+    // only the distributions of the date and shift are built here
+    generateDistributions(incidentSamples);
+    generateKDEs();
+    generateSamplers();
 }
 
 std::vector<double> MonteCarloSimulator::generateWeights(int weigthSize, double sigma) {
@@ -89,287 +74,291 @@ std::vector<double> MonteCarloSimulator::generateWeights(int weigthSize, double
     return newWeights;
 }
 
-void MonteCarloSimulator::generateHourlyIncidentProbabilityDistribution() {
-    std::vector<double> newHourlyIncidentProbabilityDistribution(24, 0);
-
-    std::vector<double> totalIncidentsPerHour(24, 0);
-    double totalIncidents = 0;
-
-    // count occurrences, weighted by distance from target date (window size)
-    for (int i = 0; i < filteredIncidents.size(); i++) {
-        std::tm timeCallReceived = Incidents::getInstance().get<std::optional<std::tm>>(
-            "time_call_received",
-            filteredIncidents[i]
-        ).value();
-
-        // calculate weight based on how far away the incident is from the target
-        int dayDiff = calculateDayDifference(timeCallReceived, month, day);
-        double weight = weights[dayDiff];
-
-        totalIncidentsPerHour[timeCallReceived.tm_hour] += weight;
-        totalIncidents += weight;
-    }
-
-    // calculate probabilities from occurrences
-    for (int i = 0; i < totalIncidentsPerHour.size(); i++) {
-        newHourlyIncidentProbabilityDistribution[i] = totalIncidentsPerHour[i] / totalIncidents;
+std::vector<IncidentSample> MonteCarloSimulator::readIncidentSamples(const std::vector<std::pair<int, int>>& dates) {
+    const Incidents& incidents = Incidents::getInstance();
+    std::vector<IncidentSample> incidentSamples(incidents.size());
+    const int windowSize = Settings::get<int>("SIMULATION_GENERATION_WINDOW_SIZE");
+    const int dayShiftStart = Settings::get<int>("DAY_SHIFT_START");
+    const int dayShiftEnd = Settings::get<int>("DAY_SHIFT_END");
+
+    // resolve columns once instead of searching the headers for every row
+    const int timeCallReceivedColumn = incidents.getColumnIndex("time_call_received");
+    const int triageColumn = incidents.getColumnIndex("triage_impression_during_call");
+    const int gridIdColumn = incidents.getColumnIndex("grid_id");
+    const int dispatchToHospitalColumn = incidents.getColumnIndex("time_ambulance_dispatch_to_hospital");
+    std::vector<std::pair<int, int>> durationColumnIndices;
+    for (const DurationColumns& columns : durationColumns) {
+        durationColumnIndices.push_back({
+            incidents.getColumnIndex(columns.fromColumn),
+            incidents.getColumnIndex(columns.toColumn)
+        });
     }
 
-    hourlyIncidentProbabilityDistribution = newHourlyIncidentProbabilityDistribution;
-}
+    auto readIncidentSample = [&](const int incidentIndex) {
+        IncidentSample& incidentSample = incidentSamples[incidentIndex];
 
-void MonteCarloSimulator::generateTriageProbabilityDistribution() {
-    std::vector<std::vector<double>> newTriageProbabilityDistribution(24, std::vector<double>(3, 0));
+        const std::tm timeCallReceived = incidents.get<std::optional<std::tm>>(timeCallReceivedColumn, incidentIndex).value();
+        incidentSample.hour = timeCallReceived.tm_hour;
+        incidentSample.callYear = incidents.getCallYear(incidentIndex);
+        incidentSample.dayOfYear = incidents.getCallDayOfYear(incidentIndex);
+        incidentSample.gridId = incidents.get<int64_t>(gridIdColumn, incidentIndex);
+        incidentSample.triageIndex = findIndex(TRIAGES, incidents.get<std::string>(triageColumn, incidentIndex));
 
-    std::vector<std::vector<double>> totalIncidentsPerTriage(24, std::vector<double>(3, 0));
-    std::vector<double> totalIncidents(24, 0);
-    int dayOfYearFinished = -1;
+        const bool eventAfterDayShiftStart = timeCallReceived.tm_hour >= dayShiftStart;
+        const bool eventBeforeDayShiftEnd = timeCallReceived.tm_hour <= dayShiftEnd;
+        incidentSample.shiftIndex = eventAfterDayShiftStart && eventBeforeDayShiftEnd ? 0 : 1;
 
-    std::vector<std::string> triageImpressions = {"A", "H", "V1"};
+        incidentSample.canceled = !incidents.get<std::optional<std::tm>>(dispatchToHospitalColumn, incidentIndex).has_value();
 
-    // count occurrences, weighted by distance from target date (window size)
-    for (int i = 0; i < filteredIncidents.size(); i++) {
-        std::tm timeCallReceived = Incidents::getInstance().get<std::optional<std::tm>>(
-            "time_call_received",
-            filteredIncidents[i]
-        ).value();
+        // delays are only sampled from incidents within the window size of a simulated date
+        incidentSample.durations.fill(std::numeric_limits<double>::quiet_NaN());
+        const bool withinWindowSize = std::any_of(dates.begin(), dates.end(), [&](const std::pair<int, int>& date) {
+            const int dayDiff = calculateDayDifference(incidentSample.callYear, incidentSample.dayOfYear, date.first, date.second);
 
-        if (timeCallReceived.tm_yday == dayOfYearFinished) {
-            continue;
-        } else {
-            dayOfYearFinished = timeCallReceived.tm_yday;
+            return dayDiff <= windowSize;
+        });
+        if (!withinWindowSize) {
+            return;
         }
 
-        int dayDiff = calculateDayDifference(timeCallReceived, month, day);
-        double weight = weights[dayDiff];
-
-        for (int indexHour = 0; indexHour < 24; indexHour++) {
-            for (int indexTriage = 0; indexTriage < 3; indexTriage++) {
-                int numIncidents = Incidents::getInstance().get<int>(
-                    "total_" + triageImpressions[indexTriage] + "_incidents_hour_" + std::to_string(indexHour),
-                    filteredIncidents[i]
-                );
-
-                double weightedNum = static_cast<double>(numIncidents) * weight;
+        for (size_t durationIndex = 0; durationIndex < durationColumns.size(); durationIndex++) {
+            std::optional<std::tm> fromTime = incidents.get<std::optional<std::tm>>(
+                durationColumnIndices[durationIndex].first,
+                incidentIndex
+            );
+            std::optional<std::tm> toTime = incidents.get<std::optional<std::tm>>(
+                durationColumnIndices[durationIndex].second,
+                incidentIndex
+            );
 
-                totalIncidentsPerTriage[indexHour][indexTriage] += weightedNum;
-                totalIncidents[indexHour] += weightedNum;
+            if (!fromTime.has_value() || !toTime.has_value()) {
+                continue;
             }
-        }
-    }
 
-    // calculate probabilities from occurrences
-    for (int indexHour = 0; indexHour < 24; indexHour++) {
-        for (int indexTriage = 0; indexTriage < 3; indexTriage++) {
-            double triageIncidentProbability = 0.0;
-            if (totalIncidents[indexHour] != 0) {
-                triageIncidentProbability = totalIncidentsPerTriage[indexHour][indexTriage] / totalIncidents[indexHour];
+            if (durationColumns[durationIndex].cancelledOnly && !incidentSample.canceled) {
+                continue;
             }
-            newTriageProbabilityDistribution[indexHour][indexTriage] = triageIncidentProbability;
+
+            incidentSample.durations[durationIndex] = timeDifferenceInSeconds(fromTime.value(), toTime.value());
         }
+    };
+
+    // rows are independent, each thread reads a contiguous block
+    const int numIncidents = incidents.size();
+    const int numThreads = std::max(std::min(getNumThreads(), numIncidents), 1);
+    const int blockSize = (numIncidents + numThreads - 1) / numThreads;
+    std::vector<std::thread> threads;
+    for (int threadIndex = 0; threadIndex < numThreads; threadIndex++) {
+        threads.emplace_back([&, threadIndex]() {
+            const int blockEnd = std::min(numIncidents, (threadIndex + 1) * blockSize);
+            for (int incidentIndex = threadIndex * blockSize; incidentIndex < blockEnd; incidentIndex++) {
+                readIncidentSample(incidentIndex);
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
     }
 
-    triageProbabilityDistribution = newTriageProbabilityDistribution;
+    return incidentSamples;
 }
 
-void MonteCarloSimulator::generateCanceledProbabilityDistribution() {
-    std::vector<std::vector<double>> newCanceledProbability(3, std::vector<double>(2, 0));
-
-    std::vector<std::vector<double>> totalIncidentsPer(3, std::vector<double>(2, 0));
-    std::vector<std::vector<double>> totalIncidents(3, std::vector<double>(2, 0));
-
-    std::vector<std::vector<int>> totalFound(3, std::vector<int>(2, 0));
-
-    // count occurrences, weighted by distance from target date (window size)
-    for (int i = 0; i < filteredIncidents.size(); i++) {
-        std::tm timeCallReceived = Incidents::getInstance().get<std::optional<std::tm>>(
-            "time_call_received",
-            filteredIncidents[i]
-        ).value();
-        int dayDiff = calculateDayDifference(timeCallReceived, month, day);
-        double weight = weights[dayDiff];
-
-        std::string triageImpression = Incidents::getInstance().get<std::string>("triage_impression_during_call", filteredIncidents[i]);
-
-        bool canceled = !Incidents::getInstance().get<std::optional<std::tm>>(
-            "time_ambulance_dispatch_to_hospital",
-            filteredIncidents[i]
-        ).has_value();
-
-        int indexTriage = -1;
-        if (triageImpression == "A") {
-            indexTriage = 0;
-        } else if (triageImpression == "H") {
-            indexTriage = 1;
-        } else if (triageImpression == "V1") {
-            indexTriage = 2;
-        }
+void MonteCarloSimulator::generateDistributions(const std::vector<IncidentSample>& incidentSamples) {
+    const Incidents& incidents = Incidents::getInstance();
+    const int numTriages = static_cast<int>(TRIAGES.size());
 
-        const bool eventAfterDayShiftStart = timeCallReceived.tm_hour >= Settings::get<int>("DAY_SHIFT_START");
-        const bool eventBeforeDayShiftEnd = timeCallReceived.tm_hour <= Settings::get<int>("DAY_SHIFT_END");
-        int indexShift = eventAfterDayShiftStart && eventBeforeDayShiftEnd ? 0 : 1;
+    weights = generateWeights(windowSize);
 
-        if (canceled) {
-            totalIncidentsPer[indexTriage][indexShift] += weight;
-            totalFound[indexTriage][indexShift]++;
-        }
-        totalIncidents[indexTriage][indexShift] += weight;
-    }
+    std::vector<double> totalIncidentsPerHour(24, 0);
+    double totalHourlyIncidents = 0;
 
-    // calculate probabilities from occurrences
-    for (int indexTriage = 0; indexTriage < 3; indexTriage++) {
-        for (int indexShift = 0; indexShift < 2; indexShift++) {
-            double totalIncidentsCanceled = totalIncidentsPer[indexTriage][indexShift];
-            if (totalFound[indexTriage][indexShift] > 1) {
-                double canceledIncidentProbability = totalIncidentsCanceled / totalIncidents[indexTriage][indexShift];
-                newCanceledProbability[indexTriage][indexShift] = canceledIncidentProbability;
-            }
+    std::vector<std::vector<double>> totalIncidentsPerTriage(24, std::vector<double>(numTriages, 0));
+    std::vector<double> totalTriageIncidents(24, 0);
+    int dayOfYearFinished = -1;
+    std::vector<std::vector<int>> triageHourColumns(24, std::vector<int>(numTriages));
+    for (int indexHour = 0; indexHour < 24; indexHour++) {
+        for (int indexTriage = 0; indexTriage < numTriages; indexTriage++) {
+            triageHourColumns[indexHour][indexTriage] = incidents.getColumnIndex(
+                "total_" + TRIAGES[indexTriage] + "_incidents_hour_" + std::to_string(indexHour)
+            );
         }
     }
 
-    canceledProbability = newCanceledProbability;
-}
-
-void MonteCarloSimulator::generateLocationProbabilityDistribution() {
-    int gridIdSize = static_cast<int>(indexToGridIdMapping.size());
-
-    std::vector<std::vector<std::vector<double>>> newLocationProbabilityDistribution(
-        3,
-        std::vector<std::vector<double>>(2, std::vector<double>(gridIdSize, 0))
-    );
+    std::vector<std::vector<double>> totalCanceledIncidents(numTriages, std::vector<double>(2, 0));
+    std::vector<std::vector<double>> totalShiftIncidents(numTriages, std::vector<double>(2, 0));
+    std::vector<std::vector<int>> totalCanceledFound(numTriages, std::vector<int>(2, 0));
 
+    // grid ids are indexed in order of first appearance, location weights grow with the index
+    std::vector<double> weightsYear = generateWeights(365, 10);
     std::vector<std::vector<std::vector<double>>> totalIncidentsPerLocation(
-        3,
-        std::vector<std::vector<double>>(2, std::vector<double>(gridIdSize, 0))
+        numTriages,
+        std::vector<std::vector<double>>(2)
     );
-    std::vector<std::vector<double>> totalIncidents(3, std::vector<double>(2, 0));
+    std::vector<std::vector<double>> totalLocationIncidents(numTriages, std::vector<double>(2, 0));
 
-    std::vector<double> weightsYear = generateWeights(365, 10);
+    // accumulate in row order so every sum is the same as when computed per distribution
+    for (const IncidentSample& incidentSample : incidentSamples) {
+        const int dayDiff = calculateDayDifference(incidentSample.callYear, incidentSample.dayOfYear, month, day);
 
-    /*std::cout << std::endl;
-    for (int i = 0; i < weightsYear.size(); i++) {
-        std::cout << weightsYear[i] << ", ";
-    }
-    std::cout << std::endl;*/
+        if (!gridIdToIndexMapping.count(incidentSample.gridId)) {
+            const int indexGridId = static_cast<int>(indexToGridIdMapping.size());
 
-    // count occurrences, weighted by distance from target date (window size)
-    for (int i = 0; i < Incidents::getInstance().size(); i++) {
-        std::tm timeCallReceived = Incidents::getInstance().get<std::optional<std::tm>>("time_call_received", i).value();
-        int dayDiff = calculateDayDifference(timeCallReceived, month, day);
-        double weight = weightsYear[dayDiff];
+            indexToGridIdMapping[indexGridId] = incidentSample.gridId;
+            gridIdToIndexMapping[incidentSample.gridId] = indexGridId;
+
+            for (std::vector<std::vector<double>>& triageLocations : totalIncidentsPerLocation) {
+                for (std::vector<double>& shiftLocations : triageLocations) {
+                    shiftLocations.push_back(0);
+                }
+            }
+        }
 
-        std::string triageImpression = Incidents::getInstance().get<std::string>("triage_impression_during_call", i);
+        const int indexTriage = incidentSample.triageIndex;
+        const int indexShift = incidentSample.shiftIndex;
 
-        int64_t gridId = Incidents::getInstance().get<int64_t>("grid_id", i);
+        // location, weighted by distance from target date over the whole year
+        if (indexTriage != -1) {
+            const double weightYear = weightsYear[dayDiff];
 
-        int indexTriage = -1;
-        if (triageImpression == "A") {
-            indexTriage = 0;
-        } else if (triageImpression == "H") {
-            indexTriage = 1;
-        } else if (triageImpression == "V1") {
-            indexTriage = 2;
+            totalIncidentsPerLocation[indexTriage][indexShift][gridIdToIndexMapping[incidentSample.gridId]] += weightYear;
+            totalLocationIncidents[indexTriage][indexShift] += weightYear;
         }
 
-        const bool eventAfterDayShiftStart = timeCallReceived.tm_hour >= Settings::get<int>("DAY_SHIFT_START");
-        const bool eventBeforeDayShiftEnd = timeCallReceived.tm_hour <= Settings::get<int>("DAY_SHIFT_END");
-        int indexShift = eventAfterDayShiftStart && eventBeforeDayShiftEnd ? 0 : 1;
+        // remaining distributions only use incidents within the window size
+        if (dayDiff > windowSize) {
+            continue;
+        }
 
-        totalIncidentsPerLocation[indexTriage][indexShift][gridIdToIndexMapping[gridId]] += weight;
-        totalIncidents[indexTriage][indexShift] += weight;
-    }
+        // count occurrences, weighted by distance from target date (window size)
+        const double weight = weights[dayDiff];
 
-    // calculate probabilities from occurrences
-    for (int indexTriage = 0; indexTriage < 3; indexTriage++) {
-        for (int indexShift = 0; indexShift < 2; indexShift++) {
-            for (int indexGridId = 0; indexGridId < gridIdSize; indexGridId++) {
-                double totalIncidentsLocation = totalIncidentsPerLocation[indexTriage][indexShift][indexGridId];
-                double locationIncidentProbability = totalIncidentsLocation / totalIncidents[indexTriage][indexShift];
-                newLocationProbabilityDistribution[indexTriage][indexShift][indexGridId] = locationIncidentProbability;
+        totalIncidentsPerHour[incidentSample.hour] += weight;
+        totalHourlyIncidents += weight;
+
+        if (indexTriage != -1) {
+            if (incidentSample.canceled) {
+                totalCanceledIncidents[indexTriage][indexShift] += weight;
+                totalCanceledFound[indexTriage][indexShift]++;
             }
+            totalShiftIncidents[indexTriage][indexShift] += weight;
         }
-    }
 
-    locationProbabilityDistribution = newLocationProbabilityDistribution;
-}
+        // hourly triage totals are stored per day, so only the first incident of each day is counted
+        if (incidentSample.dayOfYear != dayOfYearFinished) {
+            dayOfYearFinished = incidentSample.dayOfYear;
 
-void MonteCarloSimulator::generateDurationsData(
-    const std::string& fromEventColumn,
-    const std::string& toEventColumn,
-    const bool filterToCancelledEvents
-) {
-    preProcessedKDEData[std::pair(fromEventColumn, toEventColumn)] = std::vector<std::vector<KDEData>>(TRIAGES.size(), std::vector<KDEData>(2));
-
-    // generate kde data for delay for each triage and shift
-    for (size_t indexTriage = 0; indexTriage < TRIAGES.size(); indexTriage++) {
-        for (size_t indexShift = 0; indexShift < 2; indexShift++) {
-            KDEData kdeData;
-
-            for (size_t filteredIncidentsIndex = 0; filteredIncidentsIndex < filteredIncidents.size(); filteredIncidentsIndex++) {
-                const bool differentTriage = Incidents::getInstance().get<std::string>(
-                    "triage_impression_during_call",
-                    filteredIncidents[filteredIncidentsIndex]
-                ) != TRIAGES[indexTriage];
-
-                if (differentTriage) {
-                    continue;
-                }
+            const int incidentIndex = static_cast<int>(&incidentSample - incidentSamples.data());
+            for (int indexHour = 0; indexHour < 24; indexHour++) {
+                for (int indexTriageHour = 0; indexTriageHour < numTriages; indexTriageHour++) {
+                    int numIncidents = incidents.get<int>(triageHourColumns[indexHour][indexTriageHour], incidentIndex);
 
-                std::tm timeCallReceived = Incidents::getInstance().get<std::optional<std::tm>>(
-                    "time_call_received",
-                    filteredIncidents[filteredIncidentsIndex]
-                ).value();
+                    double weightedNum = static_cast<double>(numIncidents) * weight;
 
-                const bool eventAfterDayShiftStart = timeCallReceived.tm_hour >= Settings::get<int>("DAY_SHIFT_START");
-                const bool eventBeforeDayShiftEnd = timeCallReceived.tm_hour <= Settings::get<int>("DAY_SHIFT_END");
-                int eventIndexShift = eventAfterDayShiftStart && eventBeforeDayShiftEnd ? 0 : 1;
+                    totalIncidentsPerTriage[indexHour][indexTriageHour] += weightedNum;
+                    totalTriageIncidents[indexHour] += weightedNum;
+                }
+            }
+        }
 
-                if (eventIndexShift != indexShift) {
+        // delay samples for each duration, triage and shift
+        if (indexTriage != -1) {
+            for (size_t durationIndex = 0; durationIndex < NUM_DURATION_TYPES; durationIndex++) {
+                const double duration = incidentSample.durations[durationIndex];
+                if (std::isnan(duration)) {
                     continue;
                 }
 
-                const bool noValueInFromEventColumn = !Incidents::getInstance().get<std::optional<std::tm>>(
-                    fromEventColumn,
-                    filteredIncidents[filteredIncidentsIndex]
-                ).has_value();
+                KDEData& kdeData = getKDEData(static_cast<DurationType>(durationIndex), indexTriage, indexShift);
 
-                if (noValueInFromEventColumn) {
-                    continue;
-                }
+                kdeData.data.push_back(duration);
+                kdeData.weights.push_back(weight);
+            }
+        }
+    }
 
-                const bool noValueInToEventColumn = !Incidents::getInstance().get<std::optional<std::tm>>(
-                    toEventColumn,
-                    filteredIncidents[filteredIncidentsIndex]
-                ).has_value();
+    // calculate probabilities from occurrences
+    hourlyIncidentProbabilityDistribution.assign(24, 0);
+    for (int indexHour = 0; indexHour < 24; indexHour++) {
+        hourlyIncidentProbabilityDistribution[indexHour] = totalIncidentsPerHour[indexHour] / totalHourlyIncidents;
+    }
 
-                if (noValueInToEventColumn) {
-                    continue;
-                }
+    triageProbabilityDistribution.assign(24, std::vector<double>(numTriages, 0));
+    for (int indexHour = 0; indexHour < 24; indexHour++) {
+        for (int indexTriage = 0; indexTriage < numTriages; indexTriage++) {
+            if (totalTriageIncidents[indexHour] != 0) {
+                triageProbabilityDistribution[indexHour][indexTriage] =
+                    totalIncidentsPerTriage[indexHour][indexTriage] / totalTriageIncidents[indexHour];
+            }
+        }
+    }
 
-                const bool cancelledEvent = !Incidents::getInstance().get<std::optional<std::tm>>(
-                    "time_ambulance_dispatch_to_hospital",
-                    filteredIncidents[filteredIncidentsIndex]
-                ).has_value();
+    canceledProbability.assign(numTriages, std::vector<double>(2, 0));
+    for (int indexTriage = 0; indexTriage < numTriages; indexTriage++) {
+        for (int indexShift = 0; indexShift < 2; indexShift++) {
+            if (totalCanceledFound[indexTriage][indexShift] > 1) {
+                canceledProbability[indexTriage][indexShift] =
+                    totalCanceledIncidents[indexTriage][indexShift] / totalShiftIncidents[indexTriage][indexShift];
+            }
+        }
+    }
 
-                if (filterToCancelledEvents && !cancelledEvent) {
-                    continue;
-                }
+    locationProbabilityDistribution = totalIncidentsPerLocation;
+    for (int indexTriage = 0; indexTriage < numTriages; indexTriage++) {
+        for (int indexShift = 0; indexShift < 2; indexShift++) {
+            for (double& locationIncidentProbability : locationProbabilityDistribution[indexTriage][indexShift]) {
+                locationIncidentProbability /= totalLocationIncidents[indexTriage][indexShift];
+            }
+        }
+    }
+}
 
-                double duration = Incidents::getInstance().timeDifferenceBetweenHeaders(
-                    fromEventColumn,
-                    toEventColumn,
-                    filteredIncidents[filteredIncidentsIndex]
-                );
+KDEData& MonteCarloSimulator::getKDEData(const DurationType durationType, const int indexTriage, const int indexShift) {
+    return kdeTable[(static_cast<size_t>(durationType) * TRIAGES.size() + indexTriage) * 2 + indexShift];
+}
 
-                int dayDiff = calculateDayDifference(timeCallReceived, month, day);
+const KDEData& MonteCarloSimulator::getKDEData(
+    const DurationType durationType,
+    const int indexTriage,
+    const int indexShift
+) const {
+    return kdeTable[(static_cast<size_t>(durationType) * TRIAGES.size() + indexTriage) * 2 + indexShift];
+}
 
-                kdeData.data.push_back(duration);
-                kdeData.weights.push_back(weights[dayDiff]);
+void MonteCarloSimulator::generateKDEs() {
+    // each KDE is independent, threads take every n-th KDE
+    const int numKDEs = static_cast<int>(kdeTable.size());
+    const int numThreads = std::max(std::min(getNumThreads(), numKDEs), 1);
+    std::vector<std::thread> threads;
+    for (int threadIndex = 0; threadIndex < numThreads; threadIndex++) {
+        threads.emplace_back([&, threadIndex]() {
+            for (int kdeIndex = threadIndex; kdeIndex < numKDEs; kdeIndex += numThreads) {
+                precomputeKDE(kdeTable[kdeIndex]);
             }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
+
+void MonteCarloSimulator::generateSamplers() {
+    // if warm-up hour is used, generate incidents for one hour earlier than shift start
+    int warmupHour = static_cast<int>(simulate1HourBefore);
+    std::vector<std::pair<int, int>> indexRangesHour = dayShift ?
+        std::vector<std::pair<int, int>>{{config.dayShiftStart - warmupHour, config.dayShiftEnd}} :
+        std::vector<std::pair<int, int>>{{0, config.dayShiftStart - 1}, {config.dayShiftEnd + 1 - warmupHour, 23}};
+
+    hourlyIncidentSampler = WeightedSampler(hourlyIncidentProbabilityDistribution, indexRangesHour);
 
-            precomputeKDE(kdeData);
+    triageSamplers.clear();
+    for (const std::vector<double>& hourTriageProbabilityDistribution : triageProbabilityDistribution) {
+        triageSamplers.push_back(WeightedSampler(hourTriageProbabilityDistribution));
+    }
 
-            preProcessedKDEData[std::pair(fromEventColumn, toEventColumn)][indexTriage][indexShift] = std::move(kdeData);
+    locationSamplers.assign(locationProbabilityDistribution.size(), std::vector<WeightedSampler>());
+    for (size_t indexTriage = 0; indexTriage < locationProbabilityDistribution.size(); indexTriage++) {
+        for (const std::vector<double>& shiftLocationProbabilityDistribution : locationProbabilityDistribution[indexTriage]) {
+            locationSamplers[indexTriage].push_back(WeightedSampler(shiftLocationProbabilityDistribution));
         }
     }
 }
@@ -399,109 +388,118 @@ void MonteCarloSimulator::precomputeKDE(KDEData& kdeData) {
         kdeData.points.push_back(i);
     }
 
-    // set densities using gaussian kernel
-    kdeData.densities.resize(kdeData.points.size(), 0.0);
-    for (size_t i = 0; i < kdeData.points.size(); i++) {
+    // spread the sample weights onto the point grid with linear binning, exact for whole second delays
+    const size_t numPoints = kdeData.points.size();
+    std::vector<double> binnedWeights(numPoints, 0.0);
+    for (size_t j = 0; j < data.size(); j++) {
+        const double position = data[j] - minVal;
+        const size_t lowerIndex = std::min(static_cast<size_t>(position), numPoints - 1);
+        const double upperFraction = position - static_cast<double>(lowerIndex);
+
+        binnedWeights[lowerIndex] += kdeWeights[j] * (1.0 - upperFraction);
+        if (upperFraction > 0.0 && lowerIndex + 1 < numPoints) {
+            binnedWeights[lowerIndex + 1] += kdeWeights[j] * upperFraction;
+        }
+    }
+
+    // gaussian kernel evaluated once per grid offset, truncated at 8 bandwidths where it is exp(-32) (about 1.3e-14)
+    // of its peak, so densities differ from the untruncated sum by a relative error of that order
+    const double kernelCutoffBandwidths = 8.0;
+    const size_t kernelRadius = bandwidth > 0.0 ?
+        std::min(static_cast<size_t>(std::ceil(kernelCutoffBandwidths * bandwidth)), numPoints - 1) : 0;
+    std::vector<double> kernel(kernelRadius + 1, 1.0);
+    if (bandwidth > 0.0) {
+        for (size_t offset = 0; offset <= kernelRadius; offset++) {
+            kernel[offset] = gaussian_kernel(static_cast<double>(offset), 0.0, bandwidth);
+        }
+    }
+
+    // set densities by convolving the binned weights with the kernel
+    kdeData.densities.assign(numPoints, 0.0);
+    for (size_t i = 0; i < numPoints; i++) {
+        const size_t firstIndex = i >= kernelRadius ? i - kernelRadius : 0;
+        const size_t lastIndex = std::min(i + kernelRadius, numPoints - 1);
+
         double weighted_sum = 0.0;
-        for (size_t j = 0; j < data.size(); j++) {
-            weighted_sum += kdeWeights[j] * gaussian_kernel(kdeData.points[i], data[j], bandwidth);
+        for (size_t j = firstIndex; j <= lastIndex; j++) {
+            weighted_sum += binnedWeights[j] * kernel[i > j ? i - j : j - i];
         }
         kdeData.densities[i] = weighted_sum / total_weight;
     }
+
+    // normalized cumulative densities, a single point needs no table as it is always sampled
+    kdeData.cumulativeProbabilities.clear();
+    if (numPoints > 1) {
+        const double totalDensity = std::accumulate(kdeData.densities.begin(), kdeData.densities.end(), 0.0);
+
+        kdeData.cumulativeProbabilities.resize(numPoints);
+        for (size_t i = 0; i < numPoints; i++) {
+            kdeData.cumulativeProbabilities[i] = kdeData.densities[i] / totalDensity;
+        }
+        std::partial_sum(
+            kdeData.cumulativeProbabilities.begin(),
+            kdeData.cumulativeProbabilities.end(),
+            kdeData.cumulativeProbabilities.begin()
+        );
+        kdeData.cumulativeProbabilities.back() = 1.0;
+    }
 }
 
-double MonteCarloSimulator::sampleFromData(const KDEData& kdeData) {
+double MonteCarloSimulator::sampleFromData(std::mt19937& eventRnd, const KDEData& kdeData) const {
     if (kdeData.points.empty()) {
         return 0.0;
     }
 
-    std::discrete_distribution<> dist(kdeData.densities.begin(), kdeData.densities.end());
+    if (kdeData.cumulativeProbabilities.empty()) {
+        return kdeData.points[0];
+    }
 
-    // sample delay
-    return kdeData.points[dist(rnd)];
-}
+    // sample delay by inverting the precomputed CDF, draws the same delays as a discrete distribution over the densities
+    const double probability = std::generate_canonical<double, std::numeric_limits<double>::digits>(eventRnd);
+    const auto it = std::lower_bound(
+        kdeData.cumulativeProbabilities.begin(),
+        kdeData.cumulativeProbabilities.end(),
+        probability
+    );
 
-int MonteCarloSimulator::getTotalIncidentsToGenerate() {
-    std::tm date = {0};
-    date.tm_year = 119;
-    date.tm_mon = month - 1;
-    date.tm_mday = day;
-    mktime(&date);
+    return kdeData.points[std::distance(kdeData.cumulativeProbabilities.begin(), it)];
+}
 
-    int totalMorning = -1;
-    int totalDay = -1;
-    int totalNight = -1;
+int MonteCarloSimulator::getTotalIncidentsToGenerate() const {
+    const Incidents& incidents = Incidents::getInstance();
 
-    for (int i = 0; i < Incidents::getInstance().size(); i++) {
-        std::tm timeCallReceived = Incidents::getInstance().get<std::optional<std::tm>>("time_call_received", i).value();
-        mktime(&timeCallReceived);
+    // limit us to year 2018 (latest in dataset)
+    const int datasetYear = 2018;
+    const int simulatedDayOfYear = dayOfYear(year, month, day);
 
-        // limit us to year 2018 (latest in dataset)
-        if (timeCallReceived.tm_year != 118) {
-            continue;
+    // sum each triage occurance from the first incident of a day to get total incidents, -1 if the day has no incidents
+    auto sumTotalIncidents = [&](const int callDayOfYear, int hour, const int lastHour) {
+        const int incidentIndex = incidents.getFirstIndexOfDay(datasetYear, callDayOfYear);
+        if (incidentIndex == -1) {
+            return -1;
         }
 
-        // sum each triage occurance to get total incidents
-        if (timeCallReceived.tm_yday == date.tm_yday - 1 && totalNight == -1) {
-            int hour = Settings::get<int>("DAY_SHIFT_END") + 1 - static_cast<int>(Settings::get<bool>("SIMULATE_1_HOUR_BEFORE"));
-            totalNight = 0;
-
-            for (; hour < 24; hour++) {
-                totalNight += Incidents::getInstance().get<int>(
-                    "total_A_incidents_hour_" + std::to_string(hour),
-                    i
-                );
-                totalNight += Incidents::getInstance().get<int>(
-                    "total_H_incidents_hour_" + std::to_string(hour),
-                    i
-                );
-                totalNight += Incidents::getInstance().get<int>(
-                    "total_V1_incidents_hour_" + std::to_string(hour),
-                    i
-                );
+        int totalIncidents = 0;
+        for (; hour < lastHour + 1; hour++) {
+            for (const std::string& triage : TRIAGES) {
+                totalIncidents += incidents.get<int>("total_" + triage + "_incidents_hour_" + std::to_string(hour), incidentIndex);
             }
         }
-        if (timeCallReceived.tm_yday == date.tm_yday) {
-            int nightShiftEnds = Settings::get<int>("DAY_SHIFT_START") - 1;
-            totalMorning = 0;
-
-            for (int hour = 0; hour < nightShiftEnds + 1; hour++) {
-                totalMorning += Incidents::getInstance().get<int>(
-                    "total_A_incidents_hour_" + std::to_string(hour),
-                    i
-                );
-                totalMorning += Incidents::getInstance().get<int>(
-                    "total_H_incidents_hour_" + std::to_string(hour),
-                    i
-                );
-                totalMorning += Incidents::getInstance().get<int>(
-                    "total_V1_incidents_hour_" + std::to_string(hour),
-                    i
-                );
-            }
 
-            int hour = Settings::get<int>("DAY_SHIFT_START") - static_cast<int>(Settings::get<bool>("SIMULATE_1_HOUR_BEFORE"));
-            int dayShiftEnds = Settings::get<int>("DAY_SHIFT_END");
-            totalDay = 0;
-
-            for (; hour < dayShiftEnds + 1; hour++) {
-                totalDay += Incidents::getInstance().get<int>(
-                    "total_A_incidents_hour_" + std::to_string(hour),
-                    i
-                );
-                totalDay += Incidents::getInstance().get<int>(
-                    "total_H_incidents_hour_" + std::to_string(hour),
-                    i
-                );
-                totalDay += Incidents::getInstance().get<int>(
-                    "total_V1_incidents_hour_" + std::to_string(hour),
-                    i
-                );
-            }
+        return totalIncidents;
+    };
 
-            break;
-        }
-    }
+    const int totalNight = sumTotalIncidents(
+        simulatedDayOfYear - 1,
+        config.dayShiftEnd + 1 - static_cast<int>(simulate1HourBefore),
+        23
+    );
+    const int totalMorning = sumTotalIncidents(simulatedDayOfYear, 0, config.dayShiftStart - 1);
+    const int totalDay = sumTotalIncidents(
+        simulatedDayOfYear,
+        config.dayShiftStart - static_cast<int>(simulate1HourBefore),
+        config.dayShiftEnd
+    );
 
     int numEventsToGenerate = dayShift ? totalDay : totalMorning + totalNight;
 
@@ -510,99 +508,168 @@ int MonteCarloSimulator::getTotalIncidentsToGenerate() {
     return numEventsToGenerate;
 }
 
-std::vector<Event> MonteCarloSimulator::generateEvents() {
-    std::vector<Event> events;
+std::vector<std::vector<Event>> MonteCarloSimulator::generateScenarios(const int numScenarios) {
+    std::vector<std::vector<Event>> scenarios(std::max(numScenarios, 0));
+    if (scenarios.empty()) {
+        return scenarios;
+    }
+
+    const int totalEvents = getTotalIncidentsToGenerate();
+    const uint64_t seedKey = splitMix64(static_cast<uint64_t>(Settings::get<int>("SEED")));
+
+    // each scenario draws from its own stream derived from the seed and scenario index,
+    // so scenarios are the same no matter how many threads generate them
+    auto generateScenario = [&](const int scenarioIndex) {
+        const uint64_t key = splitMix64(seedKey ^ static_cast<uint64_t>(scenarioIndex));
+        std::mt19937 scenarioRnd(static_cast<std::mt19937::result_type>(key ^ (key >> 32)));
+
+        scenarios[scenarioIndex] = generateEvents(scenarioRnd, totalEvents, false);
+    };
+
+    // threads take every n-th scenario
+    const int numThreads = std::min(getNumThreads(), numScenarios);
+    std::vector<std::thread> threads;
+    for (int threadIndex = 0; threadIndex < numThreads; threadIndex++) {
+        threads.emplace_back([&, threadIndex]() {
+            for (int scenarioIndex = threadIndex; scenarioIndex < numScenarios; scenarioIndex += numThreads) {
+                generateScenario(scenarioIndex);
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
 
-    int totalEvents = getTotalIncidentsToGenerate();
+    return scenarios;
+}
 
-    std::vector<std::string> triageImpressions = { "A", "H", "V1" };
-    int indexShift = dayShift ? 0 : 1;
+std::vector<Event> MonteCarloSimulator::generateEvents() {
+    return generateEvents(rnd, getTotalIncidentsToGenerate(), true);
+}
 
-    // if warm-up hour is used, generate incidents for one hour earlier than shift start
-    int warmupHour = static_cast<int>(Settings::get<bool>("SIMULATE_1_HOUR_BEFORE"));
-    std::vector<std::pair<int, int>> indexRangesHour = dayShift ?
-        std::vector<std::pair<int, int>>{{Settings::get<int>("DAY_SHIFT_START") - warmupHour, Settings::get<int>("DAY_SHIFT_END")}} :
-        std::vector<std::pair<int, int>>{{0, Settings::get<int>("DAY_SHIFT_START") - 1}, {Settings::get<int>("DAY_SHIFT_END") + 1 - warmupHour, 23}};
+std::vector<Event> MonteCarloSimulator::generateEvents(
+    std::mt19937& eventRnd,
+    const int totalEvents,
+    const bool showProgress
+) const {
+    std::vector<Event> events;
 
-    ProgressBar progressBar(totalEvents, "Generating events");
+    std::unique_ptr<ProgressBar> progressBar = showProgress ?
+        std::make_unique<ProgressBar>(totalEvents, "Generating events") : nullptr;
     for (int i = 0; i < totalEvents; i++) {
-        Event event;
+        // get call received
+        int callReceivedHour = sampleCallReceivedHour(eventRnd);
+        int callReceivedMin = getRandomInt(eventRnd, 0, 59);
+        int callReceivedSec = getRandomInt(eventRnd, 0, 59);
 
+        Event event = generateEvent(eventRnd, callReceivedHour, callReceivedMin, callReceivedSec);
         event.id = i;
+        event.randomStreamKey = static_cast<uint64_t>(i);
 
-        // get call received
-        int callReceivedHour = weightedLottery(rnd, hourlyIncidentProbabilityDistribution, indexRangesHour);
-        int callReceivedMin = getRandomInt(rnd, 0, 59);
-        int callReceivedSec = getRandomInt(rnd, 0, 59);
-
-        event.callReceived = {0};
-        event.callReceived.tm_year = year - 1900;
-        event.callReceived.tm_mon = month - 1;
-        event.callReceived.tm_mday = day;
-        event.callReceived.tm_hour = callReceivedHour;
-        event.callReceived.tm_min = callReceivedMin;
-        event.callReceived.tm_sec = callReceivedSec;
-        mktime(&event.callReceived);
-
-        // if warm-up hour is applied and current event falls under that, set it as utility event to not influence metrics
-        if (Settings::get<bool>("SIMULATE_1_HOUR_BEFORE")) {
-            bool eventHappensDuringDayShiftWarmup = dayShift && callReceivedHour == Settings::get<int>("DAY_SHIFT_START") - warmupHour;
-            bool eventHappensDuringNightShiftWarmup = !dayShift && callReceivedHour == Settings::get<int>("DAY_SHIFT_END") + 1 - warmupHour;
-
-            if (eventHappensDuringDayShiftWarmup || eventHappensDuringNightShiftWarmup) {
-                event.utility = true;
-            }
+        events.push_back(event);
+
+        if (progressBar != nullptr) {
+            progressBar->update(i + 1);
         }
+    }
 
-        // get triage impression
-        int indexTriage = weightedLottery(rnd, triageProbabilityDistribution[callReceivedHour]);
-        event.triageImpression = triageImpressions[indexTriage];
+    return events;
+}
 
-        // check if it should be canceled
-        bool canceled = canceledProbability[indexTriage][indexShift] > getRandomDouble(rnd);
+int MonteCarloSimulator::getCallReceivedDay(const int callReceivedHour) const {
+    // night shift hours before midnight belong to the evening before on a rolling horizon
+    if (rollingHorizon && !dayShift && callReceivedHour >= config.dayShiftStart) {
+        return dayOffset - 1;
+    }
 
-        // location
-        event.gridId = indexToGridIdMapping[weightedLottery(rnd, locationProbabilityDistribution[indexTriage][indexShift])];
+    return dayOffset;
+}
 
-        // delays
-        event.secondsWaitCallAnswered = sampleFromData(
-            preProcessedKDEData[std::pair("time_call_received", "time_incident_created")][indexTriage][indexShift]
-        );
-        event.secondsWaitAppointingResource = sampleFromData(
-            preProcessedKDEData[std::pair("time_incident_created", "time_resource_appointed")][indexTriage][indexShift]
-        );
-        event.secondsWaitResourcePreparingDeparture = sampleFromData(
-            preProcessedKDEData[std::pair("time_resource_appointed", "time_ambulance_dispatch_to_scene")][indexTriage][indexShift]
-        );
+int MonteCarloSimulator::sampleCallReceivedHour(std::mt19937& eventRnd) const {
+    return hourlyIncidentSampler.sample(eventRnd);
+}
 
-        if (!canceled) {
-            event.secondsWaitDepartureScene = sampleFromData(
-                preProcessedKDEData[std::pair("time_ambulance_arrived_at_scene", "time_ambulance_dispatch_to_hospital")][indexTriage][indexShift]
-            );
-            event.secondsWaitAvailable = sampleFromData(
-                preProcessedKDEData[std::pair("time_ambulance_arrived_at_hospital", "time_ambulance_available")][indexTriage][indexShift]
-            );
-        } else {
-            event.secondsWaitAvailable = sampleFromData(
-                preProcessedKDEData[std::pair("time_ambulance_arrived_at_scene", "time_ambulance_available")][indexTriage][indexShift]
-            );
+Event MonteCarloSimulator::generateEvent(
+    std::mt19937& eventRnd,
+    const int callReceivedHour,
+    const int callReceivedMin,
+    const int callReceivedSec
+) const {
+    std::vector<std::string> triageImpressions = { "A", "H", "V1" };
+    int indexShift = dayShift ? 0 : 1;
+
+    int warmupHour = static_cast<int>(simulate1HourBefore);
+
+    Event event;
+
+    event.callReceived = SimClock::getInstance().toSimulationTime(
+        callReceivedHour,
+        callReceivedMin,
+        callReceivedSec,
+        getCallReceivedDay(callReceivedHour)
+    );
+
+    // if warm-up hour is applied and current event falls under that, set it as utility event to not influence metrics
+    if (simulate1HourBefore) {
+        bool eventHappensDuringDayShiftWarmup = dayShift && callReceivedHour == config.dayShiftStart - warmupHour;
+        bool eventHappensDuringNightShiftWarmup = !dayShift && callReceivedHour == config.dayShiftEnd + 1 - warmupHour;
+
+        if (eventHappensDuringDayShiftWarmup || eventHappensDuringNightShiftWarmup) {
+            event.utility = true;
         }
+    }
 
-        // setup timer
-        event.timer = std::mktime(&event.callReceived);
+    // get triage impression
+    int indexTriage = triageSamplers[callReceivedHour].sample(eventRnd);
+    event.triageImpression = triageImpressions[indexTriage];
 
-        event.updateTimer(static_cast<int>(event.secondsWaitCallAnswered), "duration_incident_creation");
-        // only apply half of the delay here, rest will come organically through the simulator
-        // if using another dataset (or new version of OUH dataset), see if this delay is more accurate and remove the divison by 2
-        event.updateTimer(static_cast<int>(event.secondsWaitAppointingResource / 2.0), "duration_resource_appointment");
+    // check if it should be canceled
+    bool canceled = canceledProbability[indexTriage][indexShift] > getRandomDouble(eventRnd);
 
-        // event location (event.gridId) will update as it is processed, set this for events.csv file
-        event.incidentGridId = event.gridId;
+    // location
+    event.gridId = indexToGridIdMapping.at(locationSamplers[indexTriage][indexShift].sample(eventRnd));
 
-        events.push_back(event);
+    // delays
+    event.secondsWaitCallAnswered = sampleFromData(
+        eventRnd,
+        getKDEData(DurationType::WAIT_CALL_ANSWERED, indexTriage, indexShift)
+    );
+    event.secondsWaitAppointingResource = sampleFromData(
+        eventRnd,
+        getKDEData(DurationType::WAIT_APPOINTING_RESOURCE, indexTriage, indexShift)
+    );
+    event.secondsWaitResourcePreparingDeparture = sampleFromData(
+        eventRnd,
+        getKDEData(DurationType::WAIT_RESOURCE_PREPARING_DEPARTURE, indexTriage, indexShift)
+    );
 
-        progressBar.update(i + 1);
+    if (!canceled) {
+        event.secondsWaitDepartureScene = sampleFromData(
+            eventRnd,
+            getKDEData(DurationType::WAIT_DEPARTURE_SCENE, indexTriage, indexShift)
+        );
+        event.secondsWaitAvailable = sampleFromData(
+            eventRnd,
+            getKDEData(DurationType::WAIT_AVAILABLE, indexTriage, indexShift)
+        );
+    } else {
+        event.secondsWaitAvailable = sampleFromData(
+            eventRnd,
+            getKDEData(DurationType::WAIT_AVAILABLE_CANCELLED, indexTriage, indexShift)
+        );
     }
 
-    return events;
+    // setup timer
+    event.timer = event.callReceived;
+
+    event.updateTimer(static_cast<int>(event.secondsWaitCallAnswered), EventMetric::DURATION_INCIDENT_CREATION);
+    // only apply half of the delay here, rest will come organically through the simulator
+    // if using another dataset (or new version of OUH dataset), see if this delay is more accurate and remove the divison by 2
+    event.updateTimer(static_cast<int>(event.secondsWaitAppointingResource / 2.0), EventMetric::DURATION_RESOURCE_APPOINTMENT);
+
+    // event location (event.gridId) will update as it is processed, set this for events.csv file
+    event.incidentGridId = event.gridId;
+    event.urban = Incidents::getInstance().isUrban(event.incidentGridId);
+
+    return event;
 }
@@ -0,0 +1,220 @@
+/**
+ * @file ScenarioCache.cpp
+ *
+ * @copyright Copyright (c) 2024 Emergency-Optimizers
+ */
+
+/* external libraries */
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+/* internal libraries */
+#include "simulator/ScenarioCache.hpp"
+#include "simulator/MonteCarloSimulator.hpp"
+#include "simulator/SimClock.hpp"
+#include "file-reader/Incidents.hpp"
+#include "file-reader/Settings.hpp"
+#include "Constants.hpp"
+#include "Utils.hpp"
+
+ScenarioCache::ScenarioCache() : enabled(Settings::get<bool>("SCENARIO_CACHE")) {
+    if (!enabled) {
+        return;
+    }
+
+    // incidents data is identified by its size and modification time so it does not have to be read
+    std::error_code errorCode;
+    const std::filesystem::path incidentsPath(Incidents::getFilename());
+    const uintmax_t incidentsSize = std::filesystem::file_size(incidentsPath, errorCode);
+    const auto incidentsWriteTime = std::filesystem::last_write_time(incidentsPath, errorCode);
+
+    // every setting read while generating events
+    std::stringstream keyStream;
+    keyStream
+        << "seed=" << Settings::get<int>("SEED")
+        << ";month=" << Settings::get<int>("SIMULATE_MONTH")
+        << ";day=" << Settings::get<int>("SIMULATE_DAY")
+        << ";dayShift=" << Settings::get<bool>("SIMULATE_DAY_SHIFT")
+        << ";dayShiftStart=" << Settings::get<int>("DAY_SHIFT_START")
+        << ";dayShiftEnd=" << Settings::get<int>("DAY_SHIFT_END")
+        << ";hourBefore=" << Settings::get<bool>("SIMULATE_1_HOUR_BEFORE")
+        << ";windowSize=" << Settings::get<int>("SIMULATION_GENERATION_WINDOW_SIZE")
+        << ";factor=" << Settings::get<double>("INCIDENTS_TO_GENERATE_FACTOR")
+        << ";numScenarios=" << Settings::get<int>("NUM_SCENARIOS")
+        << ";urbanMethod=" << Settings::get<std::string>("URBAN_METHOD")
+        << ";incidents=" << incidentsSize << ":" << incidentsWriteTime.time_since_epoch().count();
+    key = keyStream.str();
+
+    // file name from the FNV-1a hash of the key, the full key is stored in the file to rule out collisions
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (const char character : key) {
+        hash = (hash ^ static_cast<uint8_t>(character)) * 0x100000001b3ULL;
+    }
+
+    std::stringstream filenameStream;
+    filenameStream << "../data/" << cacheDirName << "/" << std::hex << hash << ".bin";
+    filename = filenameStream.str();
+}
+
+ScenarioCacheRecord ScenarioCache::toRecord(const Event& event) {
+    ScenarioCacheRecord record = {};
+    record.timer = static_cast<int64_t>(event.timer);
+    record.prevTimer = static_cast<int64_t>(event.prevTimer);
+    record.callReceived = static_cast<int64_t>(event.callReceived);
+    record.gridId = event.gridId;
+    record.incidentGridId = event.incidentGridId;
+    record.secondsWaitCallAnswered = event.secondsWaitCallAnswered;
+    record.secondsWaitAppointingResource = event.secondsWaitAppointingResource;
+    record.secondsWaitResourcePreparingDeparture = event.secondsWaitResourcePreparingDeparture;
+    record.secondsWaitDepartureScene = event.secondsWaitDepartureScene;
+    record.secondsWaitAvailable = event.secondsWaitAvailable;
+    std::copy(event.metrics.begin(), event.metrics.end(), record.metrics);
+    record.id = event.id;
+    record.depotIndexResponsible = event.depotIndexResponsible;
+    record.ambulanceIdResponsible = event.ambulanceIdResponsible;
+    record.allocationIndex = event.allocationIndex;
+    record.type = static_cast<uint8_t>(event.type);
+
+    const auto triage = std::find(TRIAGES.begin(), TRIAGES.end(), event.triageImpression);
+    record.triageIndex = triage != TRIAGES.end() ? static_cast<uint8_t>(std::distance(TRIAGES.begin(), triage)) : 255;
+
+    record.urban = static_cast<uint8_t>(event.urban);
+    record.utility = static_cast<uint8_t>(event.utility);
+
+    return record;
+}
+
+Event ScenarioCache::fromRecord(const ScenarioCacheRecord& record) {
+    Event event;
+    event.timer = static_cast<time_t>(record.timer);
+    event.prevTimer = static_cast<time_t>(record.prevTimer);
+    event.callReceived = static_cast<time_t>(record.callReceived);
+    event.gridId = record.gridId;
+    event.incidentGridId = record.incidentGridId;
+    event.secondsWaitCallAnswered = record.secondsWaitCallAnswered;
+    event.secondsWaitAppointingResource = record.secondsWaitAppointingResource;
+    event.secondsWaitResourcePreparingDeparture = record.secondsWaitResourcePreparingDeparture;
+    event.secondsWaitDepartureScene = record.secondsWaitDepartureScene;
+    event.secondsWaitAvailable = record.secondsWaitAvailable;
+    std::copy(record.metrics, record.metrics + NUM_EVENT_METRICS, event.metrics.begin());
+    event.id = record.id;
+    event.randomStreamKey = static_cast<uint64_t>(record.id);
+    event.depotIndexResponsible = record.depotIndexResponsible;
+    event.ambulanceIdResponsible = record.ambulanceIdResponsible;
+    event.allocationIndex = record.allocationIndex;
+    event.type = static_cast<EventType>(record.type);
+    event.triageImpression = record.triageIndex < TRIAGES.size() ? TRIAGES[record.triageIndex] : "";
+    event.urban = record.urban != 0;
+    event.utility = record.utility != 0;
+
+    return event;
+}
+
+bool ScenarioCache::load(std::vector<Event>& events, std::vector<std::vector<Event>>& scenarios) const {
+    if (!enabled) {
+        return false;
+    }
+
+    std::ifstream inFile(filename, std::ios::binary);
+    if (!inFile.is_open()) {
+        return false;
+    }
+
+    // check that the file was written by this version for the same key
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    uint32_t keySize = 0;
+    inFile.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+    inFile.read(reinterpret_cast<char*>(&version), sizeof(version));
+    inFile.read(reinterpret_cast<char*>(&keySize), sizeof(keySize));
+    if (!inFile || magic != cacheMagic || version != cacheVersion || keySize != key.size()) {
+        return false;
+    }
+
+    std::string fileKey(keySize, '\0');
+    inFile.read(&fileKey[0], keySize);
+    if (!inFile || fileKey != key) {
+        return false;
+    }
+
+    // first event set is the main events, the rest are the scenarios
+    uint32_t numEventSets = 0;
+    inFile.read(reinterpret_cast<char*>(&numEventSets), sizeof(numEventSets));
+
+    std::vector<std::vector<Event>> eventSets(numEventSets);
+    std::vector<ScenarioCacheRecord> records;
+    for (std::vector<Event>& eventSet : eventSets) {
+        uint32_t numEvents = 0;
+        inFile.read(reinterpret_cast<char*>(&numEvents), sizeof(numEvents));
+
+        records.resize(numEvents);
+        inFile.read(reinterpret_cast<char*>(records.data()), static_cast<std::streamsize>(numEvents * sizeof(ScenarioCacheRecord)));
+        if (!inFile) {
+            return false;
+        }
+
+        eventSet.reserve(numEvents);
+        for (const ScenarioCacheRecord& record : records) {
+            eventSet.push_back(fromRecord(record));
+        }
+    }
+
+    if (eventSets.empty()) {
+        return false;
+    }
+
+    // cached events are relative to the simulated date, which is otherwise set when generating them
+    SimClock::getInstance().setDate(
+        MonteCarloSimulator::year,
+        Settings::get<int>("SIMULATE_MONTH"),
+        Settings::get<int>("SIMULATE_DAY")
+    );
+
+    events = std::move(eventSets[0]);
+    scenarios.assign(std::make_move_iterator(eventSets.begin() + 1), std::make_move_iterator(eventSets.end()));
+
+    std::cout << "Loaded " << numEventSets << " event set(s) from " << filename << std::endl;
+
+    return true;
+}
+
+void ScenarioCache::save(const std::vector<Event>& events, const std::vector<std::vector<Event>>& scenarios) const {
+    if (!enabled) {
+        return;
+    }
+
+    createDirectory(cacheDirName);
+    std::ofstream outFile(filename, std::ios::binary);
+
+    // check if the file stream is open before proceeding
+    if (!outFile.is_open()) {
+        std::cerr << "Failed to open file: " << filename << std::endl;
+        return;
+    }
+
+    const uint32_t keySize = static_cast<uint32_t>(key.size());
+    const uint32_t numEventSets = static_cast<uint32_t>(1 + scenarios.size());
+    outFile.write(reinterpret_cast<const char*>(&cacheMagic), sizeof(cacheMagic));
+    outFile.write(reinterpret_cast<const char*>(&cacheVersion), sizeof(cacheVersion));
+    outFile.write(reinterpret_cast<const char*>(&keySize), sizeof(keySize));
+    outFile.write(key.data(), keySize);
+    outFile.write(reinterpret_cast<const char*>(&numEventSets), sizeof(numEventSets));
+
+    std::vector<ScenarioCacheRecord> records;
+    for (size_t eventSetIndex = 0; eventSetIndex < numEventSets; eventSetIndex++) {
+        const std::vector<Event>& eventSet = eventSetIndex == 0 ? events : scenarios[eventSetIndex - 1];
+
+        records.clear();
+        for (const Event& event : eventSet) {
+            records.push_back(toRecord(event));
+        }
+
+        const uint32_t numEvents = static_cast<uint32_t>(records.size());
+        outFile.write(reinterpret_cast<const char*>(&numEvents), sizeof(numEvents));
+        outFile.write(reinterpret_cast<const char*>(records.data()), static_cast<std::streamsize>(numEvents * sizeof(ScenarioCacheRecord)));
+    }
+
+    outFile.close();
+}
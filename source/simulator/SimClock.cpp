@@ -0,0 +1,100 @@
+/**
+ * @file SimClock.cpp
+ *
+ * @copyright Copyright (c) 2024 Emergency-Optimizers
+ */
+
+/* external libraries */
+#include <cmath>
+/* internal libraries */
+#include "simulator/SimClock.hpp"
+#include "Utils.hpp"
+
+void SimClock::setDate(const int year, const int month, const int day, const int numDays) {
+    const int ONE_HOUR = 3600;
+    const int HOURS_IN_WINDOW = (numDays + 2) * 24;
+
+    // the only place the simulator asks libc to resolve a calendar date
+    std::tm date{};
+    date.tm_year = year - 1900;
+    date.tm_mon = month - 1;
+    date.tm_mday = day;
+    date.tm_isdst = -1;
+    epoch = std::mktime(&date);
+    epochDate = date;
+
+    // precompute hour of day and day of week for each hour within the window
+    hourOfDay.resize(HOURS_IN_WINDOW);
+    dayOfWeek.resize(HOURS_IN_WINDOW);
+    for (int slot = 0; slot < HOURS_IN_WINDOW; slot++) {
+        std::tm localTime = getLocalTime(epoch + static_cast<time_t>(windowStartHour + slot) * ONE_HOUR);
+
+        hourOfDay[slot] = localTime.tm_hour;
+        dayOfWeek[slot] = localTime.tm_wday;
+    }
+
+    // precompute the offset of each wall clock hour of each day within the window (differs from hour * 3600 on DST changes)
+    secondsAtHour.resize(HOURS_IN_WINDOW);
+    for (int slot = 0; slot < HOURS_IN_WINDOW; slot++) {
+        std::tm localTime = date;
+        localTime.tm_mday += slot / 24 + windowStartHour / 24;
+        localTime.tm_hour = slot % 24;
+        localTime.tm_isdst = -1;
+
+        secondsAtHour[slot] = std::mktime(&localTime) - epoch;
+    }
+}
+
+int SimClock::getHourSlot(const time_t& time) const {
+    const int ONE_HOUR = 3600;
+
+    int slot = static_cast<int>(std::floor(static_cast<double>(time) / ONE_HOUR)) - windowStartHour;
+    if (slot < 0 || slot >= static_cast<int>(hourOfDay.size())) {
+        return -1;
+    }
+
+    return slot;
+}
+
+time_t SimClock::toSimulationTime(const int hour, const int minute, const int second, const int dayOffset) const {
+    const int slot = dayOffset * 24 + hour - windowStartHour;
+
+    time_t hourOffset;
+    if (secondsAtHour.empty()) {
+        hourOffset = static_cast<time_t>(dayOffset * 24 + hour) * 3600;
+    } else if (slot >= 0 && slot < static_cast<int>(secondsAtHour.size())) {
+        hourOffset = secondsAtHour[slot];
+    } else {
+        // fall back to libc outside the precomputed window
+        std::tm localTime = epochDate;
+        localTime.tm_mday += dayOffset;
+        localTime.tm_hour = hour;
+        localTime.tm_isdst = -1;
+
+        hourOffset = std::mktime(&localTime) - epoch;
+    }
+
+    return hourOffset + minute * 60 + second;
+}
+
+int SimClock::getHour(const time_t& time) const {
+    int slot = getHourSlot(time);
+
+    // fall back to libc outside the precomputed window
+    return slot != -1 ? hourOfDay[slot] : toLocalTime(time).tm_hour;
+}
+
+int SimClock::getDayOfWeek(const time_t& time) const {
+    int slot = getHourSlot(time);
+
+    // fall back to libc outside the precomputed window
+    return slot != -1 ? dayOfWeek[slot] : toLocalTime(time).tm_wday;
+}
+
+std::tm SimClock::toLocalTime(const time_t& time) const {
+    return getLocalTime(epoch + time);
+}
+
+std::string SimClock::toString(const time_t& time) const {
+    return tmToString(toLocalTime(time));
+}
@@ -0,0 +1,46 @@
+/**
+ * @file SimulationConfig.cpp
+ *
+ * @copyright Copyright (c) 2024 Emergency-Optimizers
+ */
+
+/* internal libraries */
+#include "simulator/SimulationConfig.hpp"
+#include "file-reader/Settings.hpp"
+#include "file-reader/Stations.hpp"
+#include "Utils.hpp"
+
+SimulationConfig SimulationConfig::fromSettings() {
+    SimulationConfig config;
+
+    config.seed = Settings::get<int>("SEED");
+    config.simulateDayShift = Settings::get<bool>("SIMULATE_DAY_SHIFT");
+    config.dayShiftStart = Settings::get<int>("DAY_SHIFT_START");
+    config.dayShiftEnd = Settings::get<int>("DAY_SHIFT_END");
+    config.simulate1HourBefore = Settings::get<bool>("SIMULATE_1_HOUR_BEFORE");
+    config.dispatchStrategy = Settings::get<DispatchEngineStrategyType>("DISPATCH_STRATEGY");
+    config.prioritizeTriage = Settings::get<bool>("DISPATCH_STRATEGY_PRIORITIZE_TRIAGE");
+    config.responseRestricted = Settings::get<bool>("DISPATCH_STRATEGY_RESPONSE_RESTRICTED");
+    config.scheduleBreaks = Settings::get<bool>("SCHEDULE_BREAKS");
+    config.commonRandomNumbers = Settings::get<bool>("COMMON_RANDOM_NUMBERS");
+    config.traceBufferSize = Settings::get<int>("TRACE_BUFFER_SIZE");
+    config.collectStats = Settings::get<bool>("COLLECT_STATS");
+
+    config.dayShiftDepotIndices = Stations::getInstance().getDepotIndices(true);
+    config.nightShiftDepotIndices = Stations::getInstance().getDepotIndices(false);
+    config.hospitalIndices = Stations::getInstance().getHospitalIndices();
+
+    for (int stationIndex = 0; stationIndex < Stations::getInstance().size(); stationIndex++) {
+        config.stationGridIds.push_back(Stations::getInstance().get<int64_t>("grid_id", stationIndex));
+    }
+
+    return config;
+}
+
+const std::vector<unsigned>& SimulationConfig::getDepotIndices(const bool dayShift) const {
+    return dayShift ? dayShiftDepotIndices : nightShiftDepotIndices;
+}
+
+bool SimulationConfig::isDayShift(const time_t& time) const {
+    return ::isDayShift(time, dayShiftStart, dayShiftEnd);
+}
@@ -0,0 +1,73 @@
+/**
+ * @file SimulationStats.cpp
+ *
+ * @copyright Copyright (c) 2024 Emergency-Optimizers
+ */
+
+/* internal libraries */
+#include "simulator/SimulationStats.hpp"
+#include "Utils.hpp"
+
+void SimulationStats::recordHandler(
+    const EventType type,
+    const int64_t nanoseconds,
+    const bool fullSort,
+    const bool waitRetry,
+    const int64_t newTravelTimeCalls
+) {
+    const size_t typeIndex = static_cast<size_t>(type);
+
+    handlerCalls[typeIndex]++;
+    handlerNanoseconds[typeIndex] += nanoseconds;
+
+    // find highest set bit to get the log2 bucket
+    size_t bucket = 0;
+    while (bucket + 1 < NUM_LATENCY_BUCKETS && (nanoseconds >> (bucket + 1)) > 0) {
+        bucket++;
+    }
+    handlerLatencyHistograms[typeIndex][bucket]++;
+
+    fullSorts += fullSort;
+    waitRetries += waitRetry;
+    travelTimeCalls += newTravelTimeCalls;
+}
+
+void SimulationStats::merge(const SimulationStats& other) {
+    for (size_t typeIndex = 0; typeIndex < NUM_EVENT_TYPES; typeIndex++) {
+        handlerCalls[typeIndex] += other.handlerCalls[typeIndex];
+        handlerNanoseconds[typeIndex] += other.handlerNanoseconds[typeIndex];
+
+        for (size_t bucket = 0; bucket < NUM_LATENCY_BUCKETS; bucket++) {
+            handlerLatencyHistograms[typeIndex][bucket] += other.handlerLatencyHistograms[typeIndex][bucket];
+        }
+    }
+
+    fullSorts += other.fullSorts;
+    waitRetries += other.waitRetries;
+    travelTimeCalls += other.travelTimeCalls;
+}
+
+std::map<std::string, std::vector<std::vector<double>>> SimulationStats::toDataMap() const {
+    std::map<std::string, std::vector<std::vector<double>>> dataMap = {
+        {"full_sorts", {{static_cast<double>(fullSorts)}}},
+        {"wait_retries", {{static_cast<double>(waitRetries)}}},
+        {"travel_time_calls", {{static_cast<double>(travelTimeCalls)}}},
+    };
+
+    // one entry per event type, named after the event type the handler processes
+    for (size_t typeIndex = 0; typeIndex < NUM_EVENT_TYPES; typeIndex++) {
+        if (handlerCalls[typeIndex] == 0) {
+            continue;
+        }
+
+        const std::string name = eventTypeToString(static_cast<EventType>(typeIndex));
+
+        dataMap["handler_calls_" + name] = {{static_cast<double>(handlerCalls[typeIndex])}};
+        dataMap["handler_nanoseconds_" + name] = {{static_cast<double>(handlerNanoseconds[typeIndex])}};
+        dataMap["handler_latency_log2_histogram_" + name] = {
+            std::vector<double>(handlerLatencyHistograms[typeIndex].begin(), handlerLatencyHistograms[typeIndex].end())
+        };
+    }
+
+    return dataMap;
+}
@@ -5,36 +5,292 @@
  */
 
 /* external libraries */
+#include <algorithm>
+#include <array>
 #include <chrono>
 #include <iomanip>
+#include <limits>
+#include <utility>
 /* internal libraries */
 #include "Utils.hpp"
 #include "simulator/Simulator.hpp"
-#include "simulator/DispatchEngine.hpp"
+#include "file-reader/ODMatrix.hpp"
+#include "simulator/strategies/ClosestDispatchEngineStrategy.hpp"
+#include "simulator/strategies/DispatchPolicy.hpp"
+#include "simulator/strategies/RandomDispatchEngineStrategy.hpp"
 
-Simulator::Simulator(
-    AmbulanceAllocator& ambulanceAllocator,
-    DispatchEngineStrategyType dispatchStrategy,
-    std::vector<Event> events
-) : ambulanceAllocator(ambulanceAllocator),
-    dispatchStrategy(dispatchStrategy),
-    eventHandler(events) { }
+Simulator::Simulator(const SimulationConfig& config) : config(config), rnd(config.seed) {
+    // dispatch strategy defined in settings.txt
+    switch (config.dispatchStrategy) {
+        case DispatchEngineStrategyType::CLOSEST:
+            selectStrategy<ClosestDispatchEngineStrategy>();
+            break;
+        default:
+            selectStrategy<RandomDispatchEngineStrategy>();
+            break;
+    }
+
+    traceRecorder.setCapacity(config.traceBufferSize);
+}
+
+template <typename Strategy, bool... flags>
+void Simulator::selectStrategy() {
+    // turn the flags in config into template arguments one at a time, in the order runStrategy takes them
+    constexpr size_t numFlags = sizeof...(flags);
+
+    if constexpr (numFlags == 4) {
+        runEvents = &Simulator::runStrategy<Strategy, flags...>;
+    } else {
+        const bool configFlags[4] = {
+            config.commonRandomNumbers,
+            config.prioritizeTriage,
+            config.responseRestricted,
+            config.scheduleBreaks
+        };
+
+        if (configFlags[numFlags]) {
+            selectStrategy<Strategy, flags..., true>();
+        } else {
+            selectStrategy<Strategy, flags..., false>();
+        }
+    }
+}
+
+void Simulator::reset(const std::vector<Event>& events, const std::vector<std::vector<int>>& allocations) {
+    // every run starts from the same seed
+    rnd.seed(config.seed);
+
+    eventHandler.reset(events);
+    traceRecorder.clear();
+
+    // allocate ambulances based on genotype, adds utility events to the queue
+    ambulanceAllocator.allocate(eventHandler.events, allocations, config);
+
+    eventHandler.sortEvents();
+}
+
+void Simulator::reset(
+    EventGenerator& eventGenerator,
+    const std::vector<std::vector<int>>& allocations,
+    const std::function<void(const Event&)>& retireEvent
+) {
+    // every run starts from the same seed
+    rnd.seed(config.seed);
+
+    // arrivals are pulled from the generator during the run and finished events are handed to retireEvent
+    eventHandler.reset(eventGenerator, retireEvent);
+    traceRecorder.clear();
+
+    // allocate ambulances based on genotype, adds utility events to the queue
+    ambulanceAllocator.allocate(eventHandler.events, allocations, config);
+    eventHandler.assignNewEventIds(0, eventHandler.events.size());
+
+    eventHandler.sortEvents();
+}
+
+void Simulator::startShift(
+    EventGenerator& eventGenerator,
+    const std::vector<std::vector<int>>& allocations,
+    const time_t& shiftStart
+) {
+    // unfinished events and ambulance states carry over, arrivals of the new shift are pulled from its generator
+    eventHandler.setEventGenerator(eventGenerator);
+
+    // reallocate ambulances to the new shift and schedule its breaks
+    const size_t numEventsBefore = eventHandler.events.size();
+    ambulanceAllocator.scheduleShift(eventHandler.events, allocations, config, shiftStart);
+    eventHandler.assignNewEventIds(numEventsBefore, eventHandler.events.size() - numEventsBefore);
+
+    eventHandler.sortEvents();
+}
+
+void Simulator::resume(const SimulationCheckpoint& checkpoint, const std::vector<std::vector<int>>& allocations) {
+    rnd = checkpoint.rnd;
+
+    eventHandler.resume(checkpoint);
+    traceRecorder.clear();
+
+    ambulanceAllocator.ambulances = checkpoint.ambulances;
+    ambulanceAllocator.availabilityIndex = checkpoint.availabilityIndex;
+    // only the time segments from the checkpoint and onwards may differ from the checkpointed genotype
+    ambulanceAllocator.genotype = allocations;
+
+    // point ambulances and events to the restored buffers of this simulator
+    for (Ambulance& ambulance : ambulanceAllocator.ambulances) {
+        ambulance.availabilityIndex = &ambulanceAllocator.availabilityIndex;
+    }
+    for (Event& event : eventHandler.events) {
+        if (event.assignedAmbulance != nullptr) {
+            event.assignedAmbulance = &ambulanceAllocator.ambulances[event.ambulanceIdResponsible];
+        }
+    }
+}
+
+std::shared_ptr<const SimulationCheckpoint> Simulator::saveCheckpoint(
+    const std::shared_ptr<const SimulationCheckpoint>& previous,
+    const int allocationIndex
+) const {
+    const std::vector<Event>& events = eventHandler.events;
+    const int currentIndex = eventHandler.getCurrentIndex();
+    const int firstNewFinishedIndex = previous == nullptr ? 0 : previous->numFinishedEvents;
+
+    // events before the current index are finished and keep their place, only the ones finished since the previous
+    // checkpoint are stored here
+    std::shared_ptr<SimulationCheckpoint> checkpoint = std::make_shared<SimulationCheckpoint>();
+    checkpoint->previous = previous;
+    checkpoint->allocationIndex = allocationIndex;
+    checkpoint->finishedEvents.assign(events.begin() + firstNewFinishedIndex, events.begin() + currentIndex);
+    checkpoint->numFinishedEvents = currentIndex;
+    checkpoint->pendingEvents.assign(events.begin() + currentIndex, events.end());
+    checkpoint->ambulances = ambulanceAllocator.ambulances;
+    checkpoint->availabilityIndex = ambulanceAllocator.availabilityIndex;
+    checkpoint->rnd = rnd;
+
+    return checkpoint;
+}
+
+const std::vector<Event>& Simulator::run(std::shared_ptr<const SimulationCheckpoint>* checkpoint) {
+    return (this->*runEvents)(checkpoint, std::numeric_limits<time_t>::max());
+}
+
+void Simulator::runUntil(const time_t& endTime) {
+    // events at or after the end time stay queued for the next call
+    (this->*runEvents)(nullptr, endTime);
+}
+
+void Simulator::swapResults(std::vector<Event>& events, std::vector<Ambulance>& ambulances) {
+    // hands over the processed events and ambulances without copying, the swapped in buffers are reused by the next reset
+    std::swap(eventHandler.events, events);
+    std::swap(ambulanceAllocator.ambulances, ambulances);
+}
+
+template <
+    typename Strategy,
+    bool commonRandomNumbers,
+    bool prioritizeTriage,
+    bool responseRestricted,
+    bool scheduleBreaks
+>
+const std::vector<Event>& Simulator::runStrategy(
+    std::shared_ptr<const SimulationCheckpoint>* checkpoint,
+    const time_t& endTime
+) {
+    const uint64_t seedKey = splitMix64(static_cast<uint64_t>(config.seed));
+
+    // travel time lookups are only counted for the stats
+    ODMatrix::countTravelTimeCalls() = config.collectStats;
 
-std::vector<Event> Simulator::run() {
     // get first event to process
     int eventIndex = eventHandler.getNextEventIndex();
 
     // continue until all events are processed
-    while (eventIndex != -1) {
+    while (eventIndex != -1 && eventHandler.events[eventIndex].timer < endTime) {
+        // save state before switching time segment so the simulation can be resumed with another genotype suffix,
+        // the given checkpoint is the last one saved or resumed from and each new one is chained onto it
+        const bool reallocation = eventHandler.events[eventIndex].type == EventType::REALLOCATE;
+        if (checkpoint != nullptr && reallocation) {
+            const int allocationIndex = eventHandler.events[eventIndex].allocationIndex;
+            const int lastAllocationIndex = *checkpoint == nullptr ? 0 : (*checkpoint)->allocationIndex;
+
+            if (allocationIndex > lastAllocationIndex) {
+                *checkpoint = saveCheckpoint(*checkpoint, allocationIndex);
+            }
+        }
+
+        // each leg and retry of an event draws from its own stream in common random numbers mode, so an event sees
+        // the same noise no matter which genotype is simulated or in which order events are processed
+        if (commonRandomNumbers) {
+            const Event& event = eventHandler.events[eventIndex];
+            uint64_t key = deriveStreamKey(seedKey, event.randomStreamKey);
+            key = deriveStreamKey(key, static_cast<uint64_t>(event.type));
+
+            eventRnd.seed(deriveStreamKey(key, static_cast<uint64_t>(event.retries)));
+        }
+
+        const EventType typeBefore = eventHandler.events[eventIndex].type;
+        const size_t numEventsBefore = eventHandler.events.size();
+        const time_t timerBefore = eventHandler.events[eventIndex].timer;
+        const std::array<int, NUM_EVENT_METRICS> metricsBefore = traceRecorder.isEnabled()
+            ? eventHandler.events[eventIndex].metrics
+            : std::array<int, NUM_EVENT_METRICS>();
+        const int64_t travelTimeCallsBefore = config.collectStats ? ODMatrix::travelTimeCalls() : 0;
+        const std::chrono::steady_clock::time_point handlerStart = config.collectStats
+            ? std::chrono::steady_clock::now()
+            : std::chrono::steady_clock::time_point();
+
         // process events
-        const bool sortAllEvents = DispatchEngine::dispatch(
-            dispatchStrategy,
-            rnd,
+        auto& handlerRnd = [this]() -> auto& {
+            if constexpr (commonRandomNumbers) {
+                return eventRnd;
+            } else {
+                return rnd;
+            }
+        }();
+        const bool sortAllEvents = Strategy::template run<DispatchPolicy<prioritizeTriage, responseRestricted, scheduleBreaks>>(
+            handlerRnd,
+            config,
             ambulanceAllocator.ambulances,
+            ambulanceAllocator.availabilityIndex,
+            ambulanceAllocator.genotype,
+            dispatchBuffers,
             eventHandler.events,
             eventIndex
         );
 
+        if (config.collectStats) {
+            const int64_t handlerNanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - handlerStart
+            ).count();
+            // an appointment still waiting after its handler found no available ambulance and was postponed
+            const bool waitRetry = typeBefore == EventType::RESOURCE_APPOINTMENT
+                && eventHandler.events[eventIndex].type == EventType::RESOURCE_APPOINTMENT;
+
+            stats.recordHandler(
+                typeBefore,
+                handlerNanoseconds,
+                sortAllEvents,
+                waitRetry,
+                ODMatrix::travelTimeCalls() - travelTimeCallsBefore
+            );
+        }
+
+        if (commonRandomNumbers) {
+            Event& event = eventHandler.events[eventIndex];
+            event.retries = event.type == typeBefore ? event.retries + 1 : 0;
+        }
+
+        // handlers insert new events right after the processed event
+        if (eventHandler.isStreaming() && eventHandler.events.size() > numEventsBefore) {
+            eventHandler.assignNewEventIds(eventIndex + 1, eventHandler.events.size() - numEventsBefore);
+        }
+
+        // record the step before events are moved by sorting
+        if (traceRecorder.isEnabled()) {
+            const Event& event = eventHandler.events[eventIndex];
+
+            // travel legs add the drawn travel time to their metric, which isn't always what the timer advanced by
+            int duration = static_cast<int>(event.timer - timerBefore);
+            for (const EventMetric metric : {
+                EventMetric::DURATION_DISPATCHING_TO_SCENE,
+                EventMetric::DURATION_DISPATCHING_TO_HOSPITAL,
+                EventMetric::DURATION_DISPATCHING_TO_DEPOT
+            }) {
+                const int metricBefore = metricsBefore[static_cast<size_t>(metric)];
+                if (event.getMetric(metric) != metricBefore) {
+                    duration = event.getMetric(metric) - std::max(metricBefore, 0);
+                }
+            }
+
+            traceRecorder.record(
+                event.timer,
+                event.id,
+                event.ambulanceIdResponsible,
+                duration,
+                typeBefore,
+                event.type
+            );
+        }
+
         // sort events
         if (sortAllEvents) {
             eventHandler.sortEvents();
@@ -0,0 +1,101 @@
+/**
+ * @file TraceRecorder.cpp
+ *
+ * @copyright Copyright (c) 2024 Emergency-Optimizers
+ */
+
+/* external libraries */
+#include <fstream>
+#include <iostream>
+/* internal libraries */
+#include "simulator/TraceRecorder.hpp"
+#include "simulator/SimClock.hpp"
+#include "Utils.hpp"
+
+void TraceRecorder::setCapacity(const int capacity) {
+    // a capacity of 0 disables tracing
+    records.assign(capacity > 0 ? capacity : 0, TraceRecord());
+
+    clear();
+}
+
+void TraceRecorder::clear() {
+    nextIndex = 0;
+    wrapped = false;
+}
+
+void TraceRecorder::record(
+    const time_t& timer,
+    const int eventId,
+    const int ambulanceId,
+    const int duration,
+    const EventType fromType,
+    const EventType toType
+) {
+    TraceRecord& traceRecord = records[nextIndex];
+    traceRecord.timer = static_cast<int64_t>(timer);
+    traceRecord.eventId = eventId;
+    traceRecord.ambulanceId = ambulanceId;
+    traceRecord.duration = duration;
+    traceRecord.fromType = static_cast<uint8_t>(fromType);
+    traceRecord.toType = static_cast<uint8_t>(toType);
+    traceRecord.padding = 0;
+
+    // overwrite the oldest records when full
+    nextIndex++;
+    if (nextIndex == records.size()) {
+        nextIndex = 0;
+        wrapped = true;
+    }
+}
+
+void TraceRecorder::write(const std::string& dirName, const std::string& fileName) const {
+    createDirectory(dirName);
+    std::string filename = "../data/" + dirName + "/" + fileName + ".bin";
+    std::ofstream outFile(filename, std::ios::binary);
+
+    // check if the file stream is open before proceeding
+    if (!outFile.is_open()) {
+        std::cerr << "Failed to open file: " << filename << std::endl;
+        return;
+    }
+
+    // write records from oldest to newest
+    if (wrapped) {
+        outFile.write(
+            reinterpret_cast<const char*>(records.data() + nextIndex),
+            static_cast<std::streamsize>((records.size() - nextIndex) * sizeof(TraceRecord))
+        );
+    }
+    outFile.write(reinterpret_cast<const char*>(records.data()), static_cast<std::streamsize>(nextIndex * sizeof(TraceRecord)));
+
+    outFile.close();
+}
+
+void TraceRecorder::decode(const std::string& traceFilename, const std::string& csvFilename) {
+    std::ifstream inFile(traceFilename, std::ios::binary);
+    std::ofstream outFile(csvFilename);
+
+    // check if the file streams are open before proceeding
+    if (!inFile.is_open() || !outFile.is_open()) {
+        std::cerr << "Failed to open file: " << traceFilename << " or " << csvFilename << std::endl;
+        return;
+    }
+
+    // write CSV header
+    outFile << "timer,seconds,event_id,ambulance_id,duration,from_type,to_type" << std::endl;
+
+    TraceRecord traceRecord;
+    while (inFile.read(reinterpret_cast<char*>(&traceRecord), sizeof(TraceRecord))) {
+        outFile
+            << SimClock::getInstance().toString(static_cast<time_t>(traceRecord.timer)) << ","
+            << traceRecord.timer << ","
+            << traceRecord.eventId << ","
+            << traceRecord.ambulanceId << ","
+            << traceRecord.duration << ","
+            << eventTypeToString(static_cast<EventType>(traceRecord.fromType)) << ","
+            << eventTypeToString(static_cast<EventType>(traceRecord.toType)) << std::endl;
+    }
+
+    outFile.close();
+}